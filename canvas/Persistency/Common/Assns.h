@@ -67,9 +67,23 @@
 // Modifiers:
 //
 //   void swap(Assns& other);
+//   void reserve(size_type n);
 //   void addSingle(Ptr<L> const&, Ptr<R> const&); // Assns<L, R> only.
 //   void addSingle(Ptr<L> const&, Ptr<R> const&, D const&);
 //
+//   // Bulk insertion by key: associates item leftKeys[i] of product
+//   // leftID with item rightKeys[i] of product rightID, for each i,
+//   // constructing each Ptr in place.
+//   void addMany(ProductID leftID, EDProductGetter const* leftGetter,
+//                LKeys const& leftKeys,
+//                ProductID rightID, EDProductGetter const* rightGetter,
+//                RKeys const& rightKeys); // Assns<L, R> only.
+//   void addMany(ProductID leftID, EDProductGetter const* leftGetter,
+//                LKeys const& leftKeys,
+//                ProductID rightID, EDProductGetter const* rightGetter,
+//                RKeys const& rightKeys,
+//                Ds const& data);
+//
 // Accessors:
 //
 //   const_iterator begin() const; // De-referencing an const_iterator
@@ -80,6 +94,35 @@
 //   D const& data(std::size_t index) const;
 //   D const& data(const_iterator it) const;
 //
+//   // Passes a prefetch hint (see EDProductGetter.h) once for each
+//   // product, left or right, holding items not yet fetched.
+//   void prefetch() const;
+//
+// Indexing (opt-in):
+//
+//   detail::AssnsIndex const& index() const;
+//   bool has_index() const;
+//
+//   The first call to index() sorts the associations by left and by
+//   right item (see detail/AssnsIndex.h); the index is then shared by
+//   all readers, and is used by FindOne and FindMany when they are
+//   constructed from collections of Ptr.  Modifying the Assns discards
+//   the index.
+//
+// Persistent representation:
+//
+//   From class version 12, the associated items may be written as a
+//   table of the products referred to, and one compact column per side
+//   holding runs of table indices and delta-coded keys (see
+//   detail/AssnsEncoding.h).  Data written with earlier versions, as
+//   one RefCore and key per item, are still read.
+//
+//   Releases before class version 12 read an Assns written in the
+//   compact form as an empty Assns, without reporting an error.  The
+//   compact form is therefore written only when enabled through
+//   detail::setCompactAssnsWrites(true); by default, Assns are still
+//   written as one RefCore and key per item, which all releases read.
+//
 ////////////////////////////////////////////////////////////////////////
 
 #include "canvas/Persistency/Common/types.h"
@@ -87,14 +130,22 @@
 #include "canvas/Persistency/Common/AssnsBase.h"
 #include "canvas/Persistency/Common/Ptr.h"
 #include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Persistency/Common/detail/AssnsEncoding.h"
+#include "canvas/Persistency/Common/detail/AssnsIndex.h"
 #include "canvas/Persistency/Common/detail/throwPartnerException.h"
 #include "canvas/Utilities/Exception.h"
 #include "canvas/Utilities/TypeID.h"
 #include "cetlib/container_algorithms.h"
 #include "cetlib_except/demangle.h"
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
+#include <iterator>
+#include <tuple>
 #include <typeinfo>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace art {
@@ -150,7 +201,14 @@ public:
   size_type size() const;
   std::string className() const;
 
+  detail::AssnsIndex const& index() const;
+  bool has_index() const noexcept;
+
+  void prefetch() const;
+
   // Modifiers.
+  void reserve(size_type n);
+
   void addSingle(Ptr<left_t> const& left, Ptr<right_t> const& right);
 
   template <typename Ls>
@@ -159,6 +217,14 @@ public:
   template <typename Rs>
   void addMany(Ptr<left_t> const& left, Rs const& rights);
 
+  template <typename LKeys, typename RKeys>
+  void addMany(ProductID leftID,
+               EDProductGetter const* leftGetter,
+               LKeys const& leftKeys,
+               ProductID rightID,
+               EDProductGetter const* rightGetter,
+               RKeys const& rightKeys);
+
   void swap(art::Assns<L, R, void>& other);
 
   std::unique_ptr<EDProduct> makePartner(
@@ -167,7 +233,7 @@ public:
   static short
   Class_Version()
   {
-    return 11;
+    return 12;
   }
 
   void
@@ -205,9 +271,21 @@ private:
   void fill_transients() override;
   void fill_from_transients() override;
 
+  // Unlike reserve(), grows geometrically.
+  void reserve_additional_(size_type n);
+
+  void fill_transients_legacy_();
+  void fill_from_transients_legacy_();
+
   ptrs_t ptrs_{}; //! transient
+  detail::AssnsIndexCache index_{}; //! transient
+  // The version 11 form: empty when written in the compact form.
   ptr_data_t ptr_data_1_{};
   ptr_data_t ptr_data_2_{};
+  // Class version >= 12, compact form only.
+  std::vector<RefCore> refs_{};
+  std::vector<unsigned char> encoded_1_{};
+  std::vector<unsigned char> encoded_2_{};
 };
 
 ////////////////////////////////////////////////////////////////////////
@@ -252,11 +330,16 @@ public:
 
   using base::operator[];
   using base::at;
+  using base::has_index;
+  using base::index;
+  using base::prefetch;
 
   data_t const& data(typename std::vector<data_t>::size_type index) const;
   data_t const& data(const_iterator it) const;
 
   // Modifiers.
+  void reserve(size_type n);
+
   void addSingle(Ptr<left_t> const& left,
                  Ptr<right_t> const& right,
                  data_t const& data);
@@ -267,6 +350,15 @@ public:
   template <typename Rs, typename Ds>
   void addMany(Ptr<left_t> const& left, Rs const& rights, Ds const& data);
 
+  template <typename LKeys, typename RKeys, typename Ds>
+  void addMany(ProductID leftID,
+               EDProductGetter const* leftGetter,
+               LKeys const& leftKeys,
+               ProductID rightID,
+               EDProductGetter const* rightGetter,
+               RKeys const& rightKeys,
+               Ds const& data);
+
   void swap(art::Assns<L, R, D>& other);
 
   // This is needed (as opposed to using base::makePartner) because
@@ -356,11 +448,76 @@ art::Assns<L, R, void>::className() const
   return assns_type.className();
 }
 
+template <typename L, typename R>
+art::detail::AssnsIndex const&
+art::Assns<L, R, void>::index() const
+{
+  return index_.get_or_build([this] {
+    std::vector<detail::AssnsIndex::Key> lefts;
+    std::vector<detail::AssnsIndex::Key> rights;
+    lefts.reserve(ptrs_.size());
+    rights.reserve(ptrs_.size());
+    for (auto const& [left, right] : ptrs_) {
+      lefts.push_back({left.id(), left.key()});
+      rights.push_back({right.id(), right.key()});
+    }
+    return detail::AssnsIndex{lefts, rights};
+  });
+}
+
+template <typename L, typename R>
+inline bool
+art::Assns<L, R, void>::has_index() const noexcept
+{
+  return index_.get() != nullptr;
+}
+
+template <typename L, typename R>
+void
+art::Assns<L, R, void>::prefetch() const
+{
+  std::unordered_set<ProductID> seen;
+  auto const prefetch_product = [&seen](RefCore const& core,
+                                        ProductID& previous) {
+    // Items of the same product usually come together.
+    if (core.id() == previous || core.productPtr() != nullptr) {
+      return;
+    }
+    previous = core.id();
+    if (seen.insert(core.id()).second) {
+      core.prefetch();
+    }
+  };
+  ProductID previous_left, previous_right;
+  for (auto const& [left, right] : ptrs_) {
+    prefetch_product(left.refCore(), previous_left);
+    prefetch_product(right.refCore(), previous_right);
+  }
+}
+
+template <typename L, typename R>
+inline void
+art::Assns<L, R, void>::reserve(size_type const n)
+{
+  ptrs_.reserve(n);
+}
+
+template <typename L, typename R>
+inline void
+art::Assns<L, R, void>::reserve_additional_(size_type const n)
+{
+  auto const wanted = ptrs_.size() + n;
+  if (wanted > ptrs_.capacity()) {
+    ptrs_.reserve(std::max(wanted, 2 * ptrs_.capacity()));
+  }
+}
+
 template <typename L, typename R>
 inline void
 art::Assns<L, R, void>::addSingle(Ptr<left_t> const& left,
                                   Ptr<right_t> const& right)
 {
+  index_.reset();
   ptrs_.emplace_back(left, right);
 }
 
@@ -373,8 +530,10 @@ art::Assns<L, R, void>::addMany(Ls const& lefts, Ptr<right_t> const& right)
                 "\n\nart error: The first argument must be a container whose "
                 "value_type is art::Ptr<L>\n"
                 "           corresponding to an Assns<L, R(, D)> object.\n");
+  index_.reset();
+  reserve_additional_(std::size(lefts));
   for (auto const& left : lefts) {
-    addSingle(left, right);
+    ptrs_.emplace_back(left, right);
   }
 }
 
@@ -387,8 +546,33 @@ art::Assns<L, R, void>::addMany(Ptr<left_t> const& left, Rs const& rights)
                 "\n\nart error: The second argument must be a container whose "
                 "value_type is art::Ptr<R>\n"
                 "           corresponding to an Assns<L, R(, D)> object.\n");
+  index_.reset();
+  reserve_additional_(std::size(rights));
   for (auto const& right : rights) {
-    addSingle(left, right);
+    ptrs_.emplace_back(left, right);
+  }
+}
+
+template <typename L, typename R>
+template <typename LKeys, typename RKeys>
+void
+art::Assns<L, R, void>::addMany(ProductID const leftID,
+                                EDProductGetter const* const leftGetter,
+                                LKeys const& leftKeys,
+                                ProductID const rightID,
+                                EDProductGetter const* const rightGetter,
+                                RKeys const& rightKeys)
+{
+  assert(std::size(leftKeys) == std::size(rightKeys));
+  index_.reset();
+  reserve_additional_(std::size(leftKeys));
+  auto rightKey = std::begin(rightKeys);
+  for (auto const leftKey : leftKeys) {
+    ptrs_.emplace_back(
+      std::piecewise_construct,
+      std::forward_as_tuple(leftID, leftKey, leftGetter),
+      std::forward_as_tuple(rightID, *rightKey, rightGetter));
+    ++rightKey;
   }
 }
 
@@ -413,8 +597,13 @@ art::Assns<L, R, void>::swap_(art::Assns<L, R, void>& other)
 {
   using std::swap;
   swap(ptrs_, other.ptrs_);
+  index_.reset();
+  other.index_.reset();
   swap(ptr_data_1_, other.ptr_data_1_);
   swap(ptr_data_2_, other.ptr_data_2_);
+  swap(refs_, other.refs_);
+  swap(encoded_1_, other.encoded_1_);
+  swap(encoded_2_, other.encoded_2_);
 }
 
 template <typename L, typename R>
@@ -442,8 +631,43 @@ template <typename L, typename R>
 void
 art::Assns<L, R, void>::fill_transients()
 {
-  // Precondition: ptr_data_1_.size() = ptr_data_2_.size();
+  index_.reset();
   ptrs_.clear();
+  if (encoded_1_.empty()) {
+    fill_transients_legacy_();
+    return;
+  }
+  detail::AssnsColumnDecoder d1{encoded_1_, refs_.size()};
+  detail::AssnsColumnDecoder d2{encoded_2_, refs_.size()};
+  if (d1.size() != d2.size()) {
+    throw Exception(errors::DataCorruption, "AssnsEncoding")
+      << "Persistent Assns data have columns of different lengths ("
+      << d1.size() << " vs " << d2.size() << ").\n";
+  }
+  auto& l_col = left_first() ? d1 : d2;
+  auto& r_col = left_first() ? d2 : d1;
+  ptrs_.reserve(d1.size());
+  for (std::size_t i{}, e = d1.size(); i != e; ++i) {
+    auto const [l_ref, l_key] = l_col.next();
+    auto const [r_ref, r_key] = r_col.next();
+    ptrs_.emplace_back(
+      std::piecewise_construct,
+      std::forward_as_tuple(
+        refs_[l_ref].id(), l_key, refs_[l_ref].productGetter()),
+      std::forward_as_tuple(
+        refs_[r_ref].id(), r_key, refs_[r_ref].productGetter()));
+  }
+  // Empty persistent representation.
+  std::vector<RefCore>{}.swap(refs_);
+  std::vector<unsigned char>{}.swap(encoded_1_);
+  std::vector<unsigned char>{}.swap(encoded_2_);
+}
+
+template <typename L, typename R>
+void
+art::Assns<L, R, void>::fill_transients_legacy_()
+{
+  // Precondition: ptr_data_1_.size() = ptr_data_2_.size();
   ptrs_.reserve(ptr_data_1_.size());
   ptr_data_t const& l_ref = left_first() ? ptr_data_1_ : ptr_data_2_;
   ptr_data_t const& r_ref = left_first() ? ptr_data_2_ : ptr_data_1_;
@@ -464,15 +688,42 @@ template <typename L, typename R>
 void
 art::Assns<L, R, void>::fill_from_transients()
 {
-  if (!ptr_data_1_.empty()) {
-    assert(ptr_data_1_.size() == ptr_data_2_.size() &&
-           ptr_data_2_.size() == ptrs_.size() &&
-           "Assns: internal inconsistency between transient and persistent "
-           "member data.");
+  if (!encoded_1_.empty() || !ptr_data_1_.empty()) {
     // Multiple output modules: nothing to do on second and subsequent
     // calls.
     return;
   }
+  if (!detail::compactAssnsWrites()) {
+    fill_from_transients_legacy_();
+    return;
+  }
+  // Both columns share the product table, and are encoded in the same
+  // order whichever the partner, so that either partner reads the
+  // data written by the other.
+  detail::AssnsColumnEncoder e1{refs_};
+  for (auto const& pr : ptrs_) {
+    if (left_first()) {
+      e1.add(pr.first.refCore(), pr.first.key());
+    } else {
+      e1.add(pr.second.refCore(), pr.second.key());
+    }
+  }
+  encoded_1_ = e1.finish();
+  detail::AssnsColumnEncoder e2{refs_};
+  for (auto const& pr : ptrs_) {
+    if (left_first()) {
+      e2.add(pr.second.refCore(), pr.second.key());
+    } else {
+      e2.add(pr.first.refCore(), pr.first.key());
+    }
+  }
+  encoded_2_ = e2.finish();
+}
+
+template <typename L, typename R>
+void
+art::Assns<L, R, void>::fill_from_transients_legacy_()
+{
   ptr_data_t& l_ref = left_first() ? ptr_data_1_ : ptr_data_2_;
   ptr_data_t& r_ref = left_first() ? ptr_data_2_ : ptr_data_1_;
   l_ref.reserve(ptrs_.size());
@@ -544,6 +795,14 @@ art::Assns<L, R, D>::data(const_iterator it) const
   return data_.at(it.getIndex());
 }
 
+template <typename L, typename R, typename D>
+inline void
+art::Assns<L, R, D>::reserve(size_type const n)
+{
+  base::reserve(n);
+  data_.reserve(n);
+}
+
 template <typename L, typename R, typename D>
 inline void
 art::Assns<L, R, D>::addSingle(Ptr<left_t> const& left,
@@ -586,6 +845,27 @@ art::Assns<L, R, D>::addMany(Ptr<left_t> const& left,
   data_.insert(data_.end(), data.begin(), data.end());
 }
 
+template <typename L, typename R, typename D>
+template <typename LKeys, typename RKeys, typename Ds>
+void
+art::Assns<L, R, D>::addMany(ProductID const leftID,
+                             EDProductGetter const* const leftGetter,
+                             LKeys const& leftKeys,
+                             ProductID const rightID,
+                             EDProductGetter const* const rightGetter,
+                             RKeys const& rightKeys,
+                             Ds const& data)
+{
+  static_assert(std::is_same_v<typename Ds::value_type, D>,
+                "\n\nart error: The data argument must be a container whose "
+                "value_type is D corresponding\n"
+                "           to an Assns<L, R, D> object.\n");
+  assert(std::size(leftKeys) == std::size(data));
+  base::addMany(
+    leftID, leftGetter, leftKeys, rightID, rightGetter, rightKeys);
+  data_.insert(data_.end(), std::begin(data), std::end(data));
+}
+
 template <typename L, typename R, typename D>
 inline void
 art::Assns<L, R, D>::swap(Assns<L, R, D>& other)
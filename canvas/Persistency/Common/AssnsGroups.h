@@ -0,0 +1,334 @@
+#ifndef canvas_Persistency_Common_AssnsGroups_h
+#define canvas_Persistency_Common_AssnsGroups_h
+// vim: set sw=2:
+
+////////////////////////////////////////////////////////////////////////
+// AssnsGroups
+//
+// Random-access view of an Assns as a sequence of groups, one per run
+// of consecutive associations sharing the same left Ptr (as grouped by
+// art::for_each_group), without requiring range-v3.
+//
+// The group boundaries are found once upon construction and kept in an
+// offsets array, so that access to any group is O(1) and yields views
+// onto the Assns' own storage: no Ptr is copied or resolved.
+//
+// Example, for an Assns<recob::Track, recob::Hit> whose associations
+// are ordered by track:
+//
+//   art::AssnsGroups const groups{*assns};
+//   for (std::size_t i{}; i != groups.size(); ++i) {
+//     auto const group = groups.group(i);
+//     art::Ptr<recob::Track> const& track = group.left();
+//     for (art::Ptr<recob::Hit> const& hit : group.rights()) { ... }
+//   }
+//
+// Notes:
+//
+// * As for art::for_each_group, a left item appearing in more than one
+// run of associations yields as many groups, and a left item with no
+// associations yields none.
+//
+// * The view refers to the Assns, which must outlive it and must not be
+// modified in the meantime.
+//
+////////////////////////////////////
+// Interface.
+//////////
+//
+// using size_type = std::size_t;
+// using assn_t = std::pair<Ptr<L>, Ptr<R>>;
+// using rights_view = ...; // Random-access range of Ptr<R> const&.
+//
+// AssnsGroups(Assns<L, R, D> const& assns);
+//
+// size_type size() const;      // Number of groups.
+// bool empty() const;
+// group_type group(size_type i) const;
+// group_type at(size_type i) const; // Bounds-checked.
+// group_type operator[](size_type i) const;
+// iterator begin() const;      // Random-access, yields group_type.
+// iterator end() const;
+// std::span<size_type const> offsets() const; // size() + 1 entries.
+//
+// group_type:
+//
+// Ptr<L> const& left() const;
+// size_type size() const;       // Number of associations (at least 1).
+// size_type first() const;      // Index of the first association.
+// std::span<assn_t const> pairs() const;
+// rights_view rights() const;
+// std::span<D const> data() const; // If D is not void.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace art {
+  template <typename L, typename R, typename D = void>
+  class AssnsGroups;
+}
+
+template <typename L, typename R, typename D>
+class art::AssnsGroups {
+public:
+  using assns_t = Assns<L, R, D>;
+  using size_type = std::size_t;
+  using assn_t = std::pair<Ptr<L>, Ptr<R>>;
+  using rights_view =
+    std::ranges::transform_view<std::span<assn_t const>, Ptr<R> assn_t::*>;
+
+  class group_type {
+  public:
+    Ptr<L> const&
+    left() const noexcept
+    {
+      return pairs_.front().first;
+    }
+
+    size_type
+    size() const noexcept
+    {
+      return pairs_.size();
+    }
+
+    size_type
+    first() const noexcept
+    {
+      return first_;
+    }
+
+    std::span<assn_t const>
+    pairs() const noexcept
+    {
+      return pairs_;
+    }
+
+    rights_view
+    rights() const
+    {
+      return rights_view{pairs_, &assn_t::second};
+    }
+
+    template <typename T = D, typename = std::enable_if_t<!std::is_void_v<T>>>
+    std::span<T const>
+    data() const
+    {
+      return {&assns_->data(first_), pairs_.size()};
+    }
+
+  private:
+    friend class AssnsGroups;
+    group_type(assns_t const* assns,
+               size_type const first,
+               std::span<assn_t const> const pairs) noexcept
+      : assns_{assns}, first_{first}, pairs_{pairs}
+    {}
+
+    assns_t const* assns_;
+    size_type first_;
+    std::span<assn_t const> pairs_;
+  };
+
+  class iterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = group_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = group_type;
+
+    iterator() = default;
+
+    group_type
+    operator*() const
+    {
+      return groups_->group(index_);
+    }
+    group_type
+    operator[](difference_type const n) const
+    {
+      return groups_->group(index_ + n);
+    }
+
+    iterator&
+    operator++() noexcept
+    {
+      ++index_;
+      return *this;
+    }
+    iterator
+    operator++(int) noexcept
+    {
+      auto result = *this;
+      ++index_;
+      return result;
+    }
+    iterator&
+    operator--() noexcept
+    {
+      --index_;
+      return *this;
+    }
+    iterator
+    operator--(int) noexcept
+    {
+      auto result = *this;
+      --index_;
+      return result;
+    }
+    iterator&
+    operator+=(difference_type const n) noexcept
+    {
+      index_ += n;
+      return *this;
+    }
+    iterator&
+    operator-=(difference_type const n) noexcept
+    {
+      index_ -= n;
+      return *this;
+    }
+    friend iterator
+    operator+(iterator it, difference_type const n) noexcept
+    {
+      return it += n;
+    }
+    friend iterator
+    operator+(difference_type const n, iterator it) noexcept
+    {
+      return it += n;
+    }
+    friend iterator
+    operator-(iterator it, difference_type const n) noexcept
+    {
+      return it -= n;
+    }
+    friend difference_type
+    operator-(iterator const& a, iterator const& b) noexcept
+    {
+      return static_cast<difference_type>(a.index_ - b.index_);
+    }
+    friend bool
+    operator==(iterator const& a, iterator const& b) noexcept
+    {
+      return a.index_ == b.index_;
+    }
+    friend auto
+    operator<=>(iterator const& a, iterator const& b) noexcept
+    {
+      return a.index_ <=> b.index_;
+    }
+
+  private:
+    friend class AssnsGroups;
+    iterator(AssnsGroups const* groups, size_type const index) noexcept
+      : groups_{groups}, index_{index}
+    {}
+
+    AssnsGroups const* groups_{nullptr};
+    size_type index_{};
+  };
+  using const_iterator = iterator;
+
+  explicit AssnsGroups(assns_t const& assns);
+
+  size_type
+  size() const noexcept
+  {
+    return offsets_.size() - 1;
+  }
+
+  bool
+  empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  group_type group(size_type i) const noexcept;
+  group_type at(size_type i) const;
+  group_type
+  operator[](size_type const i) const noexcept
+  {
+    return group(i);
+  }
+
+  iterator
+  begin() const noexcept
+  {
+    return {this, 0};
+  }
+
+  iterator
+  end() const noexcept
+  {
+    return {this, size()};
+  }
+
+  std::span<size_type const>
+  offsets() const noexcept
+  {
+    return offsets_;
+  }
+
+private:
+  assns_t const* assns_;
+  std::span<assn_t const> pairs_;
+  std::vector<size_type> offsets_;
+};
+
+template <typename L, typename R, typename D>
+art::AssnsGroups<L, R, D>::AssnsGroups(assns_t const& assns)
+  : assns_{&assns}
+{
+  auto const n = assns.size();
+  if (n != 0) {
+    pairs_ = {&assns[0], n};
+  }
+  offsets_.push_back(0);
+  for (size_type i{1}; i < n; ++i) {
+    if (pairs_[i].first != pairs_[i - 1].first) {
+      offsets_.push_back(i);
+    }
+  }
+  if (n != 0) {
+    offsets_.push_back(n);
+  }
+}
+
+template <typename L, typename R, typename D>
+inline auto
+art::AssnsGroups<L, R, D>::group(size_type const i) const noexcept
+  -> group_type
+{
+  auto const first = offsets_[i];
+  return {assns_, first, pairs_.subspan(first, offsets_[i + 1] - first)};
+}
+
+template <typename L, typename R, typename D>
+auto
+art::AssnsGroups<L, R, D>::at(size_type const i) const -> group_type
+{
+  if (i >= size()) {
+    throw Exception(errors::LogicError, "AssnsGroups::at")
+      << "Group index " << i << " is out of range (" << size()
+      << " groups).\n";
+  }
+  return group(i);
+}
+
+#endif /* canvas_Persistency_Common_AssnsGroups_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,476 @@
+#ifndef canvas_Persistency_Common_CompactPtrVector_h
+#define canvas_Persistency_Common_CompactPtrVector_h
+
+// ======================================================================
+//
+// CompactPtrVector: a read-mostly alternative to PtrVector, with the
+// same persistent form, that stores only the key of each element.
+//
+// As for PtrVector, all elements refer to items in the same product,
+// whose RefCore is held once.  The Ptrs are materialized by value on
+// access.  Upon the first access through operator[], an iterator or
+// get(), the addresses of the items are found for all elements at once,
+// with a single EDProduct::getElementAddresses call, so that the Ptrs
+// handed out are already resolved.  An element thus costs the size of
+// its key, plus that of an item pointer once resolved, instead of the
+// size of a Ptr.
+//
+// Without a product getter, or if the product cannot be found or its
+// items cannot be looked up, operator[] yields unresolved Ptrs, which
+// report the failure upon dereference as usual; get() throws right
+// away.  A failed lookup is not attempted again by operator[].
+//
+// Interface, beyond that of PtrVectorBase:
+//
+//   CompactPtrVector();
+//   explicit CompactPtrVector(PtrVector<T> const&);
+//
+//   const_iterator begin() const; // Random access, yields Ptr<T>.
+//   const_iterator end() const;
+//   size_type size() const;
+//   bool empty() const;
+//   Ptr<T> operator[](size_type i) const;
+//   Ptr<T> at(size_type i) const; // Bounds-checked.
+//   key_type key(size_type i) const;
+//   T const* get(size_type i) const; // As operator[](i).get().
+//
+//   void reserve(size_type n);
+//   void shrink_to_fit();
+//   void push_back(Ptr<T> const&);
+//   void pop_back();
+//   void clear();
+//   void swap(CompactPtrVector&);
+//
+// As for Ptr, the item pointers are cached upon first access; two
+// threads must not access the elements of the same CompactPtrVector
+// for the first time concurrently.
+//
+// ======================================================================
+
+#include "canvas/Persistency/Common/EDProduct.h"
+#include "canvas/Persistency/Common/EDProductGetter.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/PtrVector.h"
+#include "canvas/Persistency/Common/PtrVectorBase.h"
+#include "canvas/Utilities/Exception.h"
+#include "cetlib_except/demangle.h"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
+namespace art {
+  template <typename T>
+  class CompactPtrVector;
+
+  template <typename T>
+  void swap(CompactPtrVector<T>&, CompactPtrVector<T>&);
+}
+
+template <typename T>
+class art::CompactPtrVector : public PtrVectorBase {
+public:
+  using value_type = Ptr<T>;
+  using difference_type = std::ptrdiff_t;
+
+  class const_iterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Ptr<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Ptr<T>;
+
+    const_iterator() = default;
+
+    Ptr<T>
+    operator*() const
+    {
+      return (*ptrs_)[index_];
+    }
+    Ptr<T>
+    operator[](difference_type const n) const
+    {
+      return (*ptrs_)[index_ + n];
+    }
+
+    const_iterator&
+    operator++() noexcept
+    {
+      ++index_;
+      return *this;
+    }
+    const_iterator
+    operator++(int) noexcept
+    {
+      auto result = *this;
+      ++index_;
+      return result;
+    }
+    const_iterator&
+    operator--() noexcept
+    {
+      --index_;
+      return *this;
+    }
+    const_iterator
+    operator--(int) noexcept
+    {
+      auto result = *this;
+      --index_;
+      return result;
+    }
+    const_iterator&
+    operator+=(difference_type const n) noexcept
+    {
+      index_ += n;
+      return *this;
+    }
+    const_iterator&
+    operator-=(difference_type const n) noexcept
+    {
+      index_ -= n;
+      return *this;
+    }
+    friend const_iterator
+    operator+(const_iterator it, difference_type const n) noexcept
+    {
+      return it += n;
+    }
+    friend const_iterator
+    operator+(difference_type const n, const_iterator it) noexcept
+    {
+      return it += n;
+    }
+    friend const_iterator
+    operator-(const_iterator it, difference_type const n) noexcept
+    {
+      return it -= n;
+    }
+    friend difference_type
+    operator-(const_iterator const& a, const_iterator const& b) noexcept
+    {
+      return static_cast<difference_type>(a.index_ - b.index_);
+    }
+    friend bool
+    operator==(const_iterator const& a, const_iterator const& b) noexcept
+    {
+      return a.index_ == b.index_;
+    }
+    friend auto
+    operator<=>(const_iterator const& a, const_iterator const& b) noexcept
+    {
+      return a.index_ <=> b.index_;
+    }
+
+  private:
+    friend class CompactPtrVector;
+    const_iterator(CompactPtrVector const* ptrs, size_type const index)
+      : ptrs_{ptrs}, index_{index}
+    {}
+
+    CompactPtrVector const* ptrs_{nullptr};
+    size_type index_{};
+  };
+  using iterator = const_iterator;
+
+  CompactPtrVector() = default;
+  explicit CompactPtrVector(PtrVector<T> const& ptrs);
+
+  // Iterators.
+  const_iterator
+  begin() const
+  {
+    return {this, 0};
+  }
+  const_iterator
+  end() const
+  {
+    return {this, size()};
+  }
+  const_iterator
+  cbegin() const
+  {
+    return begin();
+  }
+  const_iterator
+  cend() const
+  {
+    return end();
+  }
+
+  // Capacity.
+  size_type
+  size() const
+  {
+    return keys_.size();
+  }
+  bool
+  empty() const
+  {
+    return keys_.empty();
+  }
+  void reserve(size_type n);
+  void shrink_to_fit();
+
+  // Element access.
+  Ptr<T> operator[](size_type i) const;
+  Ptr<T> at(size_type i) const;
+  key_type
+  key(size_type const i) const
+  {
+    return keys_[i];
+  }
+  T const* get(size_type i) const;
+
+  // Modifiers.
+  void push_back(Ptr<T> const& p);
+  void pop_back();
+  void clear();
+  void swap(CompactPtrVector& other);
+
+  bool operator==(CompactPtrVector const& other) const;
+
+  static short
+  Class_Version()
+  {
+    return 10;
+  }
+
+private:
+  void fill_offsets(indices_t& indices) override;
+  void fill_from_offsets(indices_t const& indices) const override;
+  void zeroTransients() override;
+
+  enum class Lookup : unsigned char { pending, found, failed };
+
+  bool find_items_() const;
+  void try_find_items_() const;
+  void fill_items_() const;
+
+  // Need to explicitly zero these from custom streamer for base class.
+  mutable indices_t keys_{};               //! transient
+  mutable std::vector<T const*> items_{};  //! transient
+  mutable Lookup lookup_{Lookup::pending}; //! transient
+};
+
+// Constructors.
+template <typename T>
+art::CompactPtrVector<T>::CompactPtrVector(PtrVector<T> const& ptrs)
+{
+  reserve(ptrs.size());
+  for (auto const& p : ptrs) {
+    push_back(p);
+  }
+}
+
+// Capacity.
+template <typename T>
+inline void
+art::CompactPtrVector<T>::reserve(size_type const n)
+{
+  keys_.reserve(n);
+}
+
+template <typename T>
+inline void
+art::CompactPtrVector<T>::shrink_to_fit()
+{
+  keys_.shrink_to_fit();
+  items_.shrink_to_fit();
+}
+
+// Element access.
+template <typename T>
+inline art::Ptr<T>
+art::CompactPtrVector<T>::operator[](size_type const i) const
+{
+  if (lookup_ == Lookup::pending && productGetter() != nullptr) {
+    try_find_items_();
+  }
+  if (i < items_.size() && items_[i] != nullptr) {
+    return Ptr<T>{id(), items_[i], keys_[i]};
+  }
+  return Ptr<T>{id(), keys_[i], productGetter()};
+}
+
+template <typename T>
+art::Ptr<T>
+art::CompactPtrVector<T>::at(size_type const i) const
+{
+  if (i >= size()) {
+    throw std::out_of_range("CompactPtrVector::at: index out of range");
+  }
+  return (*this)[i];
+}
+
+template <typename T>
+inline T const*
+art::CompactPtrVector<T>::get(size_type const i) const
+{
+  fill_items_();
+  return items_[i];
+}
+
+// Modifiers.
+template <typename T>
+void
+art::CompactPtrVector<T>::push_back(Ptr<T> const& p)
+{
+  updateCore(p.refCore());
+  keys_.push_back(p.key());
+  // Keep the items of Ptrs that are already resolved, which may not be
+  // resolvable later (e.g. those made from a pointer, without getter).
+  auto const item = static_cast<T const*>(p.refCore().productPtr());
+  if (item != nullptr || !items_.empty()) {
+    items_.resize(keys_.size());
+    items_.back() = item;
+  }
+  if (item == nullptr) {
+    lookup_ = Lookup::pending;
+  }
+}
+
+template <typename T>
+inline void
+art::CompactPtrVector<T>::pop_back()
+{
+  keys_.pop_back();
+  if (items_.size() > keys_.size()) {
+    items_.pop_back();
+  }
+}
+
+template <typename T>
+inline void
+art::CompactPtrVector<T>::clear()
+{
+  keys_.clear();
+  items_.clear();
+  lookup_ = Lookup::pending;
+  PtrVectorBase::clear();
+}
+
+template <typename T>
+inline void
+art::CompactPtrVector<T>::swap(CompactPtrVector& other)
+{
+  keys_.swap(other.keys_);
+  items_.swap(other.items_);
+  std::swap(lookup_, other.lookup_);
+  PtrVectorBase::swap(other);
+}
+
+template <typename T>
+inline bool
+art::CompactPtrVector<T>::operator==(CompactPtrVector const& other) const
+{
+  return keys_ == other.keys_ && PtrVectorBase::operator==(other);
+}
+
+template <typename T>
+inline void
+art::swap(CompactPtrVector<T>& lhs, CompactPtrVector<T>& rhs)
+{
+  lhs.swap(rhs);
+}
+
+// Private.
+template <typename T>
+void
+art::CompactPtrVector<T>::fill_offsets(indices_t& indices)
+{
+  // Precondition: indices is expected to be empty.
+  assert(indices.empty());
+  indices = keys_;
+}
+
+template <typename T>
+void
+art::CompactPtrVector<T>::fill_from_offsets(indices_t const& indices) const
+{
+  // Precondition: keys_ is expected to be empty.
+  assert(keys_.empty());
+  keys_ = indices;
+  items_.clear();
+  lookup_ = Lookup::pending;
+}
+
+template <typename T>
+inline void
+art::CompactPtrVector<T>::zeroTransients()
+{
+  indices_t{}.swap(keys_);
+  std::vector<T const*>{}.swap(items_);
+  lookup_ = Lookup::pending;
+}
+
+template <typename T>
+bool
+art::CompactPtrVector<T>::find_items_() const
+{
+  if (lookup_ == Lookup::found) {
+    return true;
+  }
+  // Until the items are found, the lookup counts as failed, also if
+  // getElementAddresses throws.
+  lookup_ = Lookup::failed;
+  items_.resize(keys_.size());
+  indices_t wanted;
+  std::vector<size_type> positions;
+  for (size_type i{}; i != keys_.size(); ++i) {
+    if (items_[i] == nullptr) {
+      wanted.push_back(keys_[i]);
+      positions.push_back(i);
+    }
+  }
+  if (!wanted.empty()) {
+    EDProduct const* product{nullptr};
+    if (productGetter()) {
+      product = productGetter()->getIt();
+    }
+    if (product == nullptr) {
+      return false;
+    }
+    auto const addresses = product->getElementAddresses(typeid(T), wanted);
+    for (size_type j{}; j != positions.size(); ++j) {
+      items_[positions[j]] = static_cast<T const*>(addresses[j]);
+    }
+  }
+  lookup_ = Lookup::found;
+  return true;
+}
+
+template <typename T>
+void
+art::CompactPtrVector<T>::try_find_items_() const
+{
+  try {
+    find_items_();
+  }
+  catch (Exception const&) {
+    // Reported upon dereference of the unresolved Ptrs.
+  }
+}
+
+template <typename T>
+void
+art::CompactPtrVector<T>::fill_items_() const
+{
+  if (!find_items_()) {
+    throw Exception(errors::ProductNotFound)
+      << "A request to resolve the items of a CompactPtrVector of type: "
+      << cet::demangle_symbol(typeid(T).name()) << " with ProductID "
+      << id()
+      << "\ncannot be satisfied because the product cannot be found.\n";
+  }
+}
+
+#endif /* canvas_Persistency_Common_CompactPtrVector_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -1,6 +1,8 @@
 #include "canvas/Persistency/Common/EDProductGetter.h"
 // vim: set sw=2 expandtab :
 
+#include <exception>
+
 namespace art {
 
   EDProductGetter::~EDProductGetter() = default;
@@ -12,10 +14,51 @@ namespace art {
     return getIt_();
   }
 
+  EDProduct const*
+  EDProductGetter::getItIfReady() const
+  {
+    return getItIfReady_();
+  }
+
+  void
+  EDProductGetter::prefetch() const
+  {
+    prefetch_();
+  }
+
+  std::future<EDProduct const*>
+  EDProductGetter::getItAsync() const
+  {
+    return getItAsync_();
+  }
+
   EDProduct const*
   EDProductGetter::getIt_() const
   {
     return nullptr;
   }
 
+  EDProduct const*
+  EDProductGetter::getItIfReady_() const
+  {
+    return nullptr;
+  }
+
+  void
+  EDProductGetter::prefetch_() const
+  {}
+
+  std::future<EDProduct const*>
+  EDProductGetter::getItAsync_() const
+  {
+    std::promise<EDProduct const*> product;
+    try {
+      product.set_value(getIt());
+    }
+    catch (...) {
+      product.set_exception(std::current_exception());
+    }
+    return product.get_future();
+  }
+
 } // namespace art
@@ -2,6 +2,8 @@
 #define canvas_Persistency_Common_EDProductGetter_h
 // vim: set sw=2 expandtab :
 
+#include <future>
+
 namespace art {
 
   class EDProduct;
@@ -21,8 +23,29 @@ namespace art {
   public:
     EDProduct const* getIt() const;
 
+    // The product, if it can be obtained without being read or
+    // produced, and nullptr otherwise.  The default implementation
+    // always returns nullptr; getters that hold their products in
+    // memory should override getItIfReady_(), which enables the bulk
+    // resolution of the items of a PtrVector when it is read.
+    EDProduct const* getItIfReady() const;
+
+    // Hint that the product will soon be wanted, so that an
+    // implementation able to read it in the background may start
+    // doing so.  The default implementation does nothing.
+    void prefetch() const;
+
+    // Obtain the product without blocking the calling thread, where
+    // the implementation allows it.  The default implementation calls
+    // getIt() and returns a ready future, holding the result or the
+    // exception thrown.
+    std::future<EDProduct const*> getItAsync() const;
+
   private:
     virtual EDProduct const* getIt_() const;
+    virtual EDProduct const* getItIfReady_() const;
+    virtual void prefetch_() const;
+    virtual std::future<EDProduct const*> getItAsync_() const;
   };
 
 } // namespace art
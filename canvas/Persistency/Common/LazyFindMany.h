@@ -0,0 +1,388 @@
+#ifndef canvas_Persistency_Common_LazyFindMany_h
+#define canvas_Persistency_Common_LazyFindMany_h
+////////////////////////////////////////////////////////////////////////
+// LazyFindMany
+//
+// A smart query object like FindMany, for sparse access: the
+// associated B (and D) objects of each A object are found in the Assns
+// upon construction, but resolved only when first accessed.
+//
+////////////////////////////////////
+// Interface.
+//////////
+//
+// Compare with the interface of FindMany, of which this is a subset.
+//
+// Notes:
+//
+// * Construction resolves the A objects of the Assns (unless the Assns
+// has been indexed and the A objects are specified as Ptrs), but no B
+// objects.  The first call to at(), data() or get() for a given index
+// resolves its B objects; later calls return the same objects.
+//
+// * The Assns must outlive the LazyFindMany, as it does when both are
+// obtained from the same event.
+//
+// * Const member functions may be called concurrently, as for the
+// other smart query objects.  First accesses are serialized, so that
+// no Ptr of the Assns is resolved by two threads at once.
+//
+// * A LazyFindMany can be neither copied nor moved.
+//
+// Useful type aliases.
+//
+// using assoc_t = ProdB;
+// using data_t = Data;
+// using value_type = std::vector<assoc_t const*>;
+// using size_type = typename std::vector<value_type>::size_type;
+// using const_reference = value_type const&;
+// using reference = value_type&;
+// using data_const_reference = typename std::vector<data_t const*> const&;
+// using data_reference = typename std::vector<data_t const*>&;
+//
+// Constructors.
+//
+// As for FindMany: from a Handle or ValidHandle to a collection of A, a
+// sequence of pointer to A (including View<A>), an arbitrary sequence
+// of Ptr<A>, or an initializer list of Ptr<A>; with a data container,
+// an input tag and an optional QueryPolicy (see QueryPolicy.h), which
+// applies to the matching done upon construction.
+//
+// Accessors.
+//
+// size_type size() const;
+// const_reference at(size_type) const;
+// data_const_reference data(size_type) const; // If Data is not void.
+// size_type get(size_type,
+//               reference)
+//   const; // Returns number of elements appended.
+// size_type get(size_type,
+//               reference,
+//               data_reference)
+//   const; // If Data is not void.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/QueryPolicy.h"
+#include "canvas/Persistency/Common/detail/IPRHelper.h"
+#include "canvas/Persistency/Common/detail/is_handle.h"
+#include "canvas/Utilities/Exception.h"
+#include "canvas/Utilities/InputTag.h"
+
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace art {
+  template <typename ProdB, typename Data = void>
+  class LazyFindMany;
+}
+
+template <typename ProdB, typename Data>
+class art::LazyFindMany {
+public:
+  using assoc_t = ProdB;
+  using data_t = Data;
+  using value_type = std::vector<assoc_t const*>;
+  using size_type = typename std::vector<value_type>::size_type;
+  using const_reference = value_type const&;
+  using reference = value_type&;
+  using data_const_reference = std::vector<data_t const*> const&;
+  using data_reference = std::vector<data_t const*>&;
+
+  template <typename Handle, typename DataContainer, typename Tag>
+  LazyFindMany(Handle const& aCollection,
+               DataContainer const& dc,
+               Tag const& tag,
+               QueryPolicy policy = QueryPolicy::sequential,
+               std::enable_if_t<detail::is_handle_v<Handle>>* = nullptr);
+
+  template <typename ProdAColl, typename DataContainer, typename Tag>
+  LazyFindMany(
+    ProdAColl const& view,
+    DataContainer const& dc,
+    Tag const& tag,
+    QueryPolicy policy = QueryPolicy::sequential,
+    std::enable_if_t<std::is_pointer_v<typename ProdAColl::value_type>>* =
+      nullptr);
+
+  template <typename PtrProdAColl, typename DataContainer, typename Tag>
+  LazyFindMany(
+    PtrProdAColl const& aPtrColl,
+    DataContainer const& dc,
+    Tag const& tag,
+    QueryPolicy policy = QueryPolicy::sequential,
+    std::enable_if_t<std::is_same_v<
+      typename PtrProdAColl::value_type,
+      art::Ptr<typename PtrProdAColl::value_type::value_type>>>* = nullptr);
+
+  template <typename ProdA, typename DataContainer, typename Tag>
+  LazyFindMany(std::initializer_list<Ptr<ProdA>> const& ptrs,
+               DataContainer const& dc,
+               Tag const& tag,
+               QueryPolicy policy = QueryPolicy::sequential);
+
+  LazyFindMany(LazyFindMany const&) = delete;
+  LazyFindMany& operator=(LazyFindMany const&) = delete;
+  ~LazyFindMany() noexcept;
+
+  // Is this a valid query (did we find an Assns)?
+  bool isValid() const;
+
+  // Number of query results
+  size_type size() const;
+
+  // Associated items by index (bounds-checked).
+  const_reference at(size_type i) const;
+
+  size_type get(size_type i, reference item) const;
+
+  // Association extra-data objects by index (bounds-checked).
+  template <typename D = Data>
+  std::enable_if_t<!std::is_void_v<D>, data_const_reference> data(
+    size_type i) const;
+
+  template <typename D = Data>
+  std::enable_if_t<!std::is_void_v<D>, size_type> get(
+    size_type i,
+    reference item,
+    data_reference data) const;
+
+private:
+  struct Entry {
+    value_type items;
+    std::vector<data_t const*> data;
+  };
+
+  template <typename ProdA,
+            typename Acoll,
+            typename DataContainer,
+            typename Tag>
+  void find_(Acoll const& aColl,
+             DataContainer const& dc,
+             Tag const& tag,
+             QueryPolicy policy);
+
+  template <typename ProdA>
+  static void append_(void const* assns, std::size_t index, Entry& entry);
+
+  Entry const& entry_(size_type i) const;
+  void throwIfInvalid() const;
+
+  void const* assns_{nullptr};
+  void (*append_fn_)(void const*, std::size_t, Entry&){nullptr};
+  detail::AssnsMatches matches_{};
+  std::unique_ptr<std::atomic<Entry const*>[]> entries_{};
+  mutable std::mutex resolveMutex_{};
+  std::shared_ptr<art::Exception const> storedException_{nullptr};
+};
+
+////////////////////////////////////////////////////////////////////////
+// Implementation.
+template <typename ProdB, typename Data>
+template <typename Handle, typename DataContainer, typename Tag>
+art::LazyFindMany<ProdB, Data>::LazyFindMany(
+  Handle const& aCollection,
+  DataContainer const& dc,
+  Tag const& tag,
+  QueryPolicy const policy,
+  std::enable_if_t<detail::is_handle_v<Handle>>*)
+{
+  using ProdA = typename Handle::element_type::value_type;
+  find_<ProdA>(*aCollection, dc, tag, policy);
+}
+
+template <typename ProdB, typename Data>
+template <typename ProdAColl, typename DataContainer, typename Tag>
+art::LazyFindMany<ProdB, Data>::LazyFindMany(
+  ProdAColl const& view,
+  DataContainer const& dc,
+  Tag const& tag,
+  QueryPolicy const policy,
+  std::enable_if_t<std::is_pointer_v<typename ProdAColl::value_type>>*)
+{
+  using ProdA =
+    std::remove_const_t<std::remove_pointer_t<typename ProdAColl::value_type>>;
+  find_<ProdA>(view, dc, tag, policy);
+}
+
+template <typename ProdB, typename Data>
+template <typename PtrProdAColl, typename DataContainer, typename Tag>
+art::LazyFindMany<ProdB, Data>::LazyFindMany(
+  PtrProdAColl const& aPtrColl,
+  DataContainer const& dc,
+  Tag const& tag,
+  QueryPolicy const policy,
+  std::enable_if_t<
+    std::is_same_v<typename PtrProdAColl::value_type,
+                   art::Ptr<typename PtrProdAColl::value_type::value_type>>>*)
+{
+  using ProdA = typename PtrProdAColl::value_type::value_type;
+  find_<ProdA>(aPtrColl, dc, tag, policy);
+}
+
+template <typename ProdB, typename Data>
+template <typename ProdA, typename DataContainer, typename Tag>
+art::LazyFindMany<ProdB, Data>::LazyFindMany(
+  std::initializer_list<Ptr<ProdA>> const& ptrs,
+  DataContainer const& dc,
+  Tag const& tag,
+  QueryPolicy const policy)
+{
+  find_<ProdA>(ptrs, dc, tag, policy);
+}
+
+template <typename ProdB, typename Data>
+art::LazyFindMany<ProdB, Data>::~LazyFindMany() noexcept
+{
+  if (!entries_) {
+    return;
+  }
+  for (size_type i{}, e = matches_.ranges.size(); i != e; ++i) {
+    delete entries_[i].load(std::memory_order_acquire);
+  }
+}
+
+template <typename ProdB, typename Data>
+template <typename ProdA, typename Acoll, typename DataContainer, typename Tag>
+void
+art::LazyFindMany<ProdB, Data>::find_(Acoll const& aColl,
+                                      DataContainer const& dc,
+                                      Tag const& tag,
+                                      QueryPolicy const policy)
+{
+  // The data collection type is immaterial, as only matching is done.
+  detail::IPRHelper<ProdA,
+                    ProdB,
+                    Data,
+                    std::vector<std::vector<Data const*>>,
+                    DataContainer> const finder{
+    dc, detail::input_tag<ProdA, ProdB, Data>(tag), policy};
+  Assns<ProdA, ProdB, Data> const* assns{nullptr};
+  storedException_ = finder.find_matches(aColl, assns, matches_);
+  assns_ = assns;
+  append_fn_ = &append_<ProdA>;
+  entries_ =
+    std::make_unique<std::atomic<Entry const*>[]>(matches_.ranges.size());
+}
+
+template <typename ProdB, typename Data>
+template <typename ProdA>
+void
+art::LazyFindMany<ProdB, Data>::append_(void const* const assns,
+                                        std::size_t const index,
+                                        Entry& entry)
+{
+  auto const& a = *static_cast<Assns<ProdA, ProdB, Data> const*>(assns);
+  auto const& apair = a[index];
+  if (!apair.first.isAvailable()) {
+    return;
+  }
+  entry.items.push_back(apair.second ? apair.second.get() : nullptr);
+  if constexpr (!std::is_void_v<Data>) {
+    entry.data.push_back(&a.data(index));
+  }
+}
+
+template <typename ProdB, typename Data>
+auto
+art::LazyFindMany<ProdB, Data>::entry_(size_type const i) const
+  -> Entry const&
+{
+  throwIfInvalid();
+  auto const [begin, end] = matches_.ranges.at(i);
+  auto& slot = entries_[i];
+  if (auto const entry = slot.load(std::memory_order_acquire)) {
+    return *entry;
+  }
+  std::lock_guard sentry{resolveMutex_};
+  if (auto const entry = slot.load(std::memory_order_relaxed)) {
+    return *entry; // Resolved while waiting.
+  }
+  auto fresh = std::make_unique<Entry>();
+  for (auto j = begin; j != end; ++j) {
+    append_fn_(assns_, matches_.order[j], *fresh);
+  }
+  slot.store(fresh.get(), std::memory_order_release);
+  return *fresh.release();
+}
+
+template <typename ProdB, typename Data>
+inline bool
+art::LazyFindMany<ProdB, Data>::isValid() const
+{
+  return storedException_.get() == nullptr;
+}
+
+template <typename ProdB, typename Data>
+inline auto
+art::LazyFindMany<ProdB, Data>::size() const -> size_type
+{
+  throwIfInvalid();
+  return matches_.ranges.size();
+}
+
+template <typename ProdB, typename Data>
+inline auto
+art::LazyFindMany<ProdB, Data>::at(size_type const i) const
+  -> const_reference
+{
+  return entry_(i).items;
+}
+
+template <typename ProdB, typename Data>
+inline auto
+art::LazyFindMany<ProdB, Data>::get(size_type const i, reference item) const
+  -> size_type
+{
+  const_reference ref(at(i));
+  item.insert(item.end(), ref.begin(), ref.end());
+  return ref.size();
+}
+
+template <typename ProdB, typename Data>
+template <typename D>
+inline std::enable_if_t<
+  !std::is_void_v<D>,
+  typename art::LazyFindMany<ProdB, Data>::data_const_reference>
+art::LazyFindMany<ProdB, Data>::data(size_type const i) const
+{
+  return entry_(i).data;
+}
+
+template <typename ProdB, typename Data>
+template <typename D>
+inline std::enable_if_t<!std::is_void_v<D>,
+                        typename art::LazyFindMany<ProdB, Data>::size_type>
+art::LazyFindMany<ProdB, Data>::get(size_type const i,
+                                    reference item,
+                                    data_reference data) const
+{
+  auto const& entry = entry_(i);
+  item.insert(item.end(), entry.items.begin(), entry.items.end());
+  data.insert(data.end(), entry.data.begin(), entry.data.end());
+  return entry.items.size();
+}
+
+template <typename ProdB, typename Data>
+inline void
+art::LazyFindMany<ProdB, Data>::throwIfInvalid() const
+{
+  if (!isValid()) {
+    throw Exception(
+      errors::LogicError, "Invalid LazyFindMany", *storedException_)
+      << "Attempt to use a LazyFindMany where the underlying "
+         "art::Assns product was not found.";
+  }
+}
+
+#endif /* canvas_Persistency_Common_LazyFindMany_h */
+
+// Local Variables:
+// mode: c++
+// End:
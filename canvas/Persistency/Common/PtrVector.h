@@ -6,10 +6,19 @@
 // PtrVector: a container which returns art::Ptr<>'s referring to items
 // in one container in the art::Event
 //
+// When a PtrVector is read, the addresses of all of its items are found
+// with a single EDProduct::getElementAddresses call, provided that its
+// product getter can hand out the product through getItIfReady().  The
+// default EDProductGetter::getItIfReady() returns nullptr, so this has
+// no effect until the framework's getters override getItIfReady_();
+// until then, each element is resolved upon its first dereference, as
+// before.
+//
 // ======================================================================
 
 #include "canvas/Persistency/Common/Ptr.h"
 #include "canvas/Persistency/Common/PtrVectorBase.h"
+#include "canvas/Utilities/Exception.h"
 #include "cetlib/container_algorithms.h"
 
 #include <initializer_list>
@@ -152,9 +161,11 @@ private:
 };
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <iterator>
 #include <type_traits>
+#include <typeinfo>
 
 // Constructors.
 template <typename T>
@@ -576,9 +587,29 @@ art::PtrVector<T>::fill_from_offsets(indices_t const& indices) const
 {
   // Precondition: ptrs_ is expected to be empty.
   assert(ptrs_.empty());
+  auto const productID = id();
+  auto const getter = productGetter();
+
+  // If the product is already in memory, find all items at once, so
+  // that dereferencing the elements needs no further lookup.  A failed
+  // lookup is left to be reported upon dereference, as it would be
+  // otherwise.
+  std::vector<void const*> addresses;
+  if (auto const product = getter ? getter->getItIfReady() : nullptr) {
+    try {
+      addresses = product->getElementAddresses(typeid(T), indices);
+    }
+    catch (Exception const&) {
+      addresses.clear();
+    }
+  }
+
   ptrs_.reserve(indices.size());
-  for (auto i : indices) {
-    ptrs_.emplace_back(id(), i, productGetter());
+  for (std::size_t i{}; i != indices.size(); ++i) {
+    auto const& p = ptrs_.emplace_back(productID, indices[i], getter);
+    if (!addresses.empty()) {
+      p.refCore().setProductPtr(addresses[i]);
+    }
   }
 }
 
@@ -31,6 +31,10 @@ public:
   ProductID id() const noexcept;
   EDProductGetter const* productGetter() const noexcept;
 
+  // Hint that the items will soon be dereferenced: all items are in
+  // the same product.
+  void prefetch() const;
+
   // Mutators
   void setProductGetter(EDProductGetter const*) noexcept;
 
@@ -76,6 +80,12 @@ art::PtrVectorBase::isAvailable() const
   return core_.isAvailable();
 }
 
+inline void
+art::PtrVectorBase::prefetch() const
+{
+  core_.prefetch();
+}
+
 inline art::ProductID
 art::PtrVectorBase::id() const noexcept
 {
@@ -0,0 +1,28 @@
+#ifndef canvas_Persistency_Common_QueryPolicy_h
+#define canvas_Persistency_Common_QueryPolicy_h
+// vim: set sw=2:
+
+// ======================================================================
+//
+// QueryPolicy: How the smart query objects (FindOne, FindOneP,
+// FindMany and FindManyP) are constructed.
+//
+// With QueryPolicy::parallel, the associations are matched to the
+// reference collection, and the associated items resolved, by parallel
+// tasks.  The results, including any exception thrown, are identical to
+// those of a sequential construction; the tasks join the calling
+// thread's task arena, so that a module using the parallel policy
+// shares the framework's worker threads.  The parallel policy pays off
+// only for large queries (of order 10^4 reference items or more).
+//
+// ======================================================================
+
+namespace art {
+  enum class QueryPolicy { sequential, parallel };
+}
+
+#endif /* canvas_Persistency_Common_QueryPolicy_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -30,6 +30,15 @@ namespace art {
            productGetter()->getIt() != nullptr;
   }
 
+  void
+  RefCore::prefetch() const
+  {
+    if (productPtr() == nullptr && id_.isValid() &&
+        productGetter() != nullptr) {
+      productGetter()->prefetch();
+    }
+  }
+
   void const*
   RefCore::productPtr() const noexcept
   {
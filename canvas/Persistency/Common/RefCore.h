@@ -46,6 +46,10 @@ namespace art {
     // fetched yet.
     bool isAvailable() const;
 
+    // Passes a prefetch hint to the productGetter() if the product has
+    // not been fetched yet.
+    void prefetch() const;
+
     constexpr ProductID
     id() const noexcept
     {
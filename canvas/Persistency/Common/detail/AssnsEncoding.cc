@@ -0,0 +1,173 @@
+#include "canvas/Persistency/Common/detail/AssnsEncoding.h"
+// vim: set sw=2:
+
+#include "canvas/Utilities/Exception.h"
+
+#include <atomic>
+#include <cstdint>
+
+using namespace art::detail;
+
+namespace {
+
+  std::atomic<bool> compact_writes{false};
+
+  void
+  put_varint(std::vector<unsigned char>& out, std::uint64_t value)
+  {
+    while (value >= 0x80) {
+      out.push_back(static_cast<unsigned char>(value | 0x80));
+      value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+  }
+
+  [[noreturn]] void
+  throw_corrupt(char const* const what)
+  {
+    throw art::Exception(art::errors::DataCorruption, "AssnsEncoding")
+      << "Malformed persistent Assns data: " << what << ".\n";
+  }
+
+  std::uint64_t
+  get_varint(unsigned char const*& pos, unsigned char const* const end)
+  {
+    std::uint64_t result{};
+    for (unsigned shift{}; shift < 64; shift += 7) {
+      if (pos == end) {
+        throw_corrupt("truncated integer");
+      }
+      auto const byte = *pos++;
+      result |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return result;
+      }
+    }
+    throw_corrupt("overlong integer");
+  }
+
+  // Key differences are taken modulo 2^64, and the zigzag mapping keeps
+  // small negative differences small.
+  std::uint64_t
+  zigzag(std::uint64_t const delta)
+  {
+    return (delta << 1) ^ (0 - (delta >> 63));
+  }
+
+  std::uint64_t
+  unzigzag(std::uint64_t const value)
+  {
+    return (value >> 1) ^ (0 - (value & 1));
+  }
+
+} // unnamed namespace
+
+bool
+art::detail::compactAssnsWrites() noexcept
+{
+  return compact_writes.load(std::memory_order_relaxed);
+}
+
+void
+art::detail::setCompactAssnsWrites(bool const enable) noexcept
+{
+  compact_writes.store(enable, std::memory_order_relaxed);
+}
+
+// ======================================================================
+// AssnsColumnEncoder
+
+AssnsColumnEncoder::AssnsColumnEncoder(std::vector<RefCore>& table)
+  : table_{table}
+{
+  for (std::size_t i{}; i != table_.size(); ++i) {
+    indices_.emplace(table_[i].id(), i);
+  }
+}
+
+void
+AssnsColumnEncoder::add(RefCore const& ref, std::size_t const key)
+{
+  if (run_length_ == 0 || table_[run_index_].id() != ref.id()) {
+    end_run_();
+    auto const [it, inserted] = indices_.emplace(ref.id(), table_.size());
+    if (inserted) {
+      table_.push_back(ref);
+    }
+    run_index_ = it->second;
+  }
+  ++run_length_;
+  put_varint(keys_, zigzag(key - previous_key_));
+  previous_key_ = key;
+  ++size_;
+}
+
+void
+AssnsColumnEncoder::end_run_()
+{
+  if (run_length_ == 0) {
+    return;
+  }
+  put_varint(runs_, run_index_);
+  put_varint(runs_, run_length_);
+  ++n_runs_;
+  run_length_ = 0;
+}
+
+std::vector<unsigned char>
+AssnsColumnEncoder::finish()
+{
+  end_run_();
+  std::vector<unsigned char> result;
+  result.reserve(2 * sizeof(std::uint64_t) + runs_.size() + keys_.size());
+  put_varint(result, size_);
+  put_varint(result, n_runs_);
+  result.insert(result.end(), runs_.begin(), runs_.end());
+  result.insert(result.end(), keys_.begin(), keys_.end());
+  runs_.clear();
+  keys_.clear();
+  size_ = n_runs_ = run_index_ = previous_key_ = 0;
+  return result;
+}
+
+// ======================================================================
+// AssnsColumnDecoder
+
+AssnsColumnDecoder::AssnsColumnDecoder(
+  std::vector<unsigned char> const& encoded,
+  std::size_t const table_size)
+  : runs_{encoded.data()}
+  , keys_{encoded.data()}
+  , end_{encoded.data() + encoded.size()}
+  , size_{get_varint(runs_, end_)}
+{
+  auto n_runs = get_varint(runs_, end_);
+  keys_ = runs_;
+  std::uint64_t total{};
+  while (n_runs-- != 0) {
+    if (get_varint(keys_, end_) >= table_size) {
+      throw_corrupt("product table index out of range");
+    }
+    auto const length = get_varint(keys_, end_);
+    if (length == 0 || length > size_ - total) {
+      throw_corrupt("inconsistent product runs");
+    }
+    total += length;
+  }
+  if (total != size_) {
+    throw_corrupt("inconsistent product runs");
+  }
+}
+
+std::pair<std::size_t, std::size_t>
+AssnsColumnDecoder::next()
+{
+  if (run_left_ == 0) {
+    // The run headers were validated upon construction.
+    run_index_ = get_varint(runs_, end_);
+    run_left_ = get_varint(runs_, end_);
+  }
+  --run_left_;
+  previous_key_ += unzigzag(get_varint(keys_, end_));
+  return {run_index_, previous_key_};
+}
@@ -0,0 +1,112 @@
+#ifndef canvas_Persistency_Common_detail_AssnsEncoding_h
+#define canvas_Persistency_Common_detail_AssnsEncoding_h
+// vim: set sw=2:
+
+// ======================================================================
+//
+// The compact persistent representation of an Assns (class version
+// 12 onwards).
+//
+// Each of the two columns of an Assns (the left and right items of
+// the associations) is encoded as one byte vector, and the products
+// referred to by either column are listed once, as RefCore objects,
+// in a table shared by both columns.  A column is laid out as:
+//
+//   varint      number of items, n
+//   varint      number of runs, r
+//   r times     varint table index, varint run length
+//   n times     zigzag varint difference from the previous key
+//
+// Items in a run refer to the same product.  An association
+// collection usually refers to one or two products, and to items in
+// ascending (or nearly so) order, so that each item occupies about one
+// byte rather than a full RefCore and key.
+//
+// The table holds RefCore (rather than ProductID) objects so that the
+// product getters are set upon reading, as for any other RefCore.
+//
+// Forward compatibility: releases before class version 12 know only
+// the version 11 members (one RefCore and key per item), and read an
+// Assns written in the compact form as empty, without any error.  The
+// compact form is therefore written only once enabled with
+// setCompactAssnsWrites(true), which should be done only when every
+// reader of the files written understands class version 12.  By
+// default, Assns are written in the version 11 form, which all
+// releases read.
+//
+// ======================================================================
+
+#include "canvas/Persistency/Common/RefCore.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace art::detail {
+
+  // Whether Assns are written in the compact form (false by default).
+  bool compactAssnsWrites() noexcept;
+  void setCompactAssnsWrites(bool enable) noexcept;
+
+  class AssnsColumnEncoder {
+  public:
+    // The table is shared by the encoders of both columns: products
+    // already in it are reused, and others are appended as they are
+    // met.
+    explicit AssnsColumnEncoder(std::vector<RefCore>& table);
+
+    void add(RefCore const& ref, std::size_t key);
+
+    // Returns the encoded column, and resets the encoder.
+    std::vector<unsigned char> finish();
+
+  private:
+    void end_run_();
+
+    std::vector<RefCore>& table_;
+    std::unordered_map<ProductID, std::size_t, ProductID::Hash> indices_{};
+    std::vector<unsigned char> runs_{};
+    std::vector<unsigned char> keys_{};
+    std::size_t size_{};
+    std::size_t n_runs_{};
+    std::size_t run_index_{};
+    std::size_t run_length_{};
+    std::size_t previous_key_{};
+  };
+
+  class AssnsColumnDecoder {
+  public:
+    // Throws if the header of the column is malformed, or if it refers
+    // to products beyond the end of a table of the given size.
+    AssnsColumnDecoder(std::vector<unsigned char> const& encoded,
+                       std::size_t table_size);
+
+    std::size_t
+    size() const noexcept
+    {
+      return size_;
+    }
+
+    // Returns the table index and key of the next item.  Throws if the
+    // keys are truncated.
+    std::pair<std::size_t, std::size_t> next();
+
+  private:
+    unsigned char const* runs_;
+    unsigned char const* keys_;
+    unsigned char const* const end_;
+    std::size_t size_;
+    std::size_t run_index_{};
+    std::size_t run_left_{};
+    std::size_t previous_key_{};
+  };
+
+} // namespace art::detail
+
+#endif /* canvas_Persistency_Common_detail_AssnsEncoding_h */
+
+// Local Variables:
+// mode: c++
+// End:
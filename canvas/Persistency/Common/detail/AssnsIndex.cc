@@ -0,0 +1,65 @@
+#include "canvas/Persistency/Common/detail/AssnsIndex.h"
+// vim: set sw=2:
+
+#include <algorithm>
+
+using namespace art::detail;
+
+namespace {
+
+  std::vector<AssnsIndex::Entry>
+  sorted_entries(std::vector<AssnsIndex::Key> const& keys)
+  {
+    std::vector<AssnsIndex::Entry> result;
+    result.reserve(keys.size());
+    for (std::size_t i{}; i != keys.size(); ++i) {
+      result.push_back({keys[i], i});
+    }
+    // Stable, so that each item's entries remain in association order.
+    std::stable_sort(
+      result.begin(), result.end(), [](auto const& a, auto const& b) {
+        return a.key < b.key;
+      });
+    return result;
+  }
+
+  struct CompareKeys {
+    bool
+    operator()(AssnsIndex::Entry const& a, AssnsIndex::Key const& b) const
+    {
+      return a.key < b;
+    }
+    bool
+    operator()(AssnsIndex::Key const& a, AssnsIndex::Entry const& b) const
+    {
+      return a < b.key;
+    }
+  };
+
+  std::span<AssnsIndex::Entry const>
+  equal_range(std::span<AssnsIndex::Entry const> const entries,
+              AssnsIndex::Key const& key)
+  {
+    auto const [b, e] =
+      std::equal_range(entries.begin(), entries.end(), key, CompareKeys{});
+    return {b, e};
+  }
+
+} // unnamed namespace
+
+AssnsIndex::AssnsIndex(std::vector<Key> const& lefts,
+                       std::vector<Key> const& rights)
+  : left_{sorted_entries(lefts)}, right_{sorted_entries(rights)}
+{}
+
+std::span<AssnsIndex::Entry const>
+AssnsIndex::by_left(Key const& key) const noexcept
+{
+  return equal_range(left_, key);
+}
+
+std::span<AssnsIndex::Entry const>
+AssnsIndex::by_right(Key const& key) const noexcept
+{
+  return equal_range(right_, key);
+}
@@ -0,0 +1,134 @@
+#ifndef canvas_Persistency_Common_detail_AssnsIndex_h
+#define canvas_Persistency_Common_detail_AssnsIndex_h
+// vim: set sw=2:
+
+// ======================================================================
+//
+// AssnsIndex: The associations of an Assns, sorted by the product ID
+// and key of their left items and, separately, of their right items,
+// so that the associations of a given item are found by binary search.
+// Within each item's range, entries are in association order.
+//
+// AssnsIndexCache: Holds an AssnsIndex that is built on first request
+// and then shared by all readers of the Assns.  Building is
+// thread-safe: concurrent first requests may each build an index, but
+// only one is published and the others are discarded.  Copying a
+// cache yields an empty one, as the copy may be modified.
+//
+// ======================================================================
+
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace art::detail {
+
+  class AssnsIndex {
+  public:
+    struct Key {
+      ProductID id;
+      std::size_t key;
+
+      bool
+      operator<(Key const& other) const noexcept
+      {
+        return id < other.id || (id == other.id && key < other.key);
+      }
+    };
+
+    struct Entry {
+      Key key;
+      std::size_t index; // Of the association within the Assns
+    };
+
+    // The keys of the left and right items, in association order.
+    AssnsIndex(std::vector<Key> const& lefts,
+               std::vector<Key> const& rights);
+
+    // All entries, sorted by key.
+    std::span<Entry const>
+    by_left() const noexcept
+    {
+      return left_;
+    }
+    std::span<Entry const>
+    by_right() const noexcept
+    {
+      return right_;
+    }
+
+    // The entries of the associations with the given item.
+    std::span<Entry const> by_left(Key const& key) const noexcept;
+    std::span<Entry const> by_right(Key const& key) const noexcept;
+
+  private:
+    std::vector<Entry> left_;
+    std::vector<Entry> right_;
+  };
+
+  class AssnsIndexCache {
+  public:
+    AssnsIndexCache() = default;
+    AssnsIndexCache(AssnsIndexCache const&) noexcept {}
+    AssnsIndexCache&
+    operator=(AssnsIndexCache const&) noexcept
+    {
+      reset();
+      return *this;
+    }
+    ~AssnsIndexCache() noexcept { reset(); }
+
+    // Null if the index has not been built.
+    AssnsIndex const*
+    get() const noexcept
+    {
+      return index_.load(std::memory_order_acquire);
+    }
+
+    // Make is invoked to build the index if it does not exist.
+    template <typename Make>
+    AssnsIndex const& get_or_build(Make make) const;
+
+    // Must not be called while the index may be in use.
+    void
+    reset() noexcept
+    {
+      if (get() != nullptr) {
+        delete index_.exchange(nullptr, std::memory_order_acq_rel);
+      }
+    }
+
+  private:
+    mutable std::atomic<AssnsIndex const*> index_{nullptr};
+  };
+
+  template <typename Make>
+  AssnsIndex const&
+  AssnsIndexCache::get_or_build(Make make) const
+  {
+    if (auto const index = get()) {
+      return *index;
+    }
+    auto fresh = std::make_unique<AssnsIndex const>(make());
+    AssnsIndex const* expected{nullptr};
+    if (index_.compare_exchange_strong(expected,
+                                       fresh.get(),
+                                       std::memory_order_acq_rel,
+                                       std::memory_order_acquire)) {
+      return *fresh.release();
+    }
+    // Another thread published its index first.
+    return *expected;
+  }
+
+} // namespace art::detail
+
+#endif /* canvas_Persistency_Common_detail_AssnsIndex_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -6,13 +6,19 @@
 
 #include "canvas/Persistency/Common/Assns.h"
 #include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/QueryPolicy.h"
+#include "canvas/Persistency/Common/detail/parallel_query.h"
 #include "canvas/Persistency/Provenance/ProductToken.h"
 #include "canvas/Utilities/Exception.h"
 #include "canvas/Utilities/InputTag.h"
 #include "canvas/Utilities/ensurePointer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace art::detail {
 
@@ -42,6 +48,15 @@ namespace art::detail {
 
   class IPRHelperDef {};
 
+  // The associations of each item of a reference collection: those of
+  // item i are the associations order[ranges[i].first] to
+  // order[ranges[i].second - 1], in association order.  The left items
+  // of some may be unavailable.
+  struct AssnsMatches {
+    std::vector<std::size_t> order;
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+  };
+
   template <typename ProdA,
             typename ProdB,
             typename Data,
@@ -130,7 +145,11 @@ private:
 public:
   using shared_exception_t = std::shared_ptr<art::Exception const>;
 
-  IPRHelper(EVENT const& e, InputTag const& tag) : event_{e}, assnsTag_{tag} {}
+  IPRHelper(EVENT const& e,
+            InputTag const& tag,
+            QueryPolicy const policy = QueryPolicy::sequential)
+    : event_{e}, assnsTag_{tag}, policy_{policy}
+  {}
 
   // template <typename A, typename B> shared_exception_t operator()(A const& a,
   // B const& b) const
@@ -148,9 +167,29 @@ public:
                                 Bcoll& bColl,
                                 dataColl_t& dColl) const;
 
+  // 3. Finds the associations of each item of aColl without resolving
+  // the associated items, which are left to the caller.
+  template <typename Acoll>
+  shared_exception_t find_matches(Acoll const& aColl,
+                                  Assns<ProdA, ProdB, Data> const*& assns,
+                                  AssnsMatches& matches) const;
+
 private:
+  template <typename Acoll>
+  AssnsMatches match_(Acoll const& aColl,
+                      Assns<ProdA, ProdB, Data> const& assns) const;
+
+  template <typename Acoll, typename Bcoll>
+  void fill_in_parallel_(Acoll const& aColl,
+                         Assns<ProdA, ProdB, Data> const& assns,
+                         BcollHelper<ProdB>& bh,
+                         DataCollHelper<Data> const& dh,
+                         Bcoll& bColl,
+                         dataColl_t& dColl) const;
+
   EVENT const& event_;
   InputTag const assnsTag_;
+  QueryPolicy const policy_;
 };
 
 // 1.
@@ -194,6 +233,12 @@ art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::operator()(
 // ProductID and only if they matched, the pointer with suitable get().
 //
 // For now however, no-one has requested this,
+//
+// If the Assns has been indexed (see Assns::index()) and the reference
+// collection is a collection of Ptrs, the associated items of each
+// reference item are instead found by binary search of the index on
+// product ID and key; no cache need be built, and only the Ptrs of
+// matching associations are checked for availability.
 ////////////////////////////////////////////////////////////////////////
 template <typename ProdA,
           typename ProdB,
@@ -216,6 +261,29 @@ art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::operator()(
   }
   bh.init(aColl.size(), bColl);
   dh.init(aColl.size(), dColl);
+  auto const& assns = *assnsHandle;
+  if (policy_ == QueryPolicy::parallel) {
+    fill_in_parallel_(aColl, assns, bh, dh, bColl, dColl);
+    return shared_exception_t();
+  }
+  if constexpr (std::is_convertible_v<typename Acoll::value_type,
+                                      Ptr<ProdA>>) {
+    if (assns.has_index()) {
+      auto const& index = assns.index();
+      size_t bIndex{0};
+      for (Ptr<ProdA> const& aPtr : aColl) {
+        for (auto const& entry : index.by_left({aPtr.id(), aPtr.key()})) {
+          auto const& apair = assns[entry.index];
+          if (apair.first.isAvailable()) {
+            bh.fill(bIndex, apair.second, bColl);
+            dh.fill(entry.index, assns, bIndex, dColl);
+          }
+        }
+        ++bIndex;
+      }
+      return shared_exception_t();
+    }
+  }
   // Answer cache.
   std::unordered_multimap<typename Ptr<ProdA>::const_pointer,
                           std::pair<Ptr<ProdB>, ptrdiff_t>>
@@ -229,26 +297,212 @@ art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::operator()(
     }
     ++counter;
   }
-  // Now use the cache.
+  // Now use the cache.  The order of equivalent elements of an
+  // unordered_multimap is unspecified, so the matches are presented in
+  // association order, as they are when using the index.
+  std::vector<typename decltype(lookupCache)::mapped_type const*> matches;
   size_t bIndex{0};
   using std::cbegin;
   using std::cend;
   for (auto i = cbegin(aColl), e = cend(aColl); i != e; ++i, ++bIndex) {
     auto foundItems = lookupCache.equal_range(
       ensurePointer<typename Ptr<ProdA>::const_pointer>(i));
-    if (foundItems.first != lookupCache.cend()) {
-      std::for_each(
-        foundItems.first,
-        foundItems.second,
-        [&bh, &dh, &bColl, bIndex, &assnsHandle, &dColl](auto const& itemPair) {
-          bh.fill(bIndex, itemPair.second.first, bColl);
-          dh.fill(itemPair.second.second, *assnsHandle, bIndex, dColl);
-        });
+    matches.clear();
+    for (auto it = foundItems.first; it != foundItems.second; ++it) {
+      matches.push_back(&it->second);
+    }
+    std::sort(matches.begin(), matches.end(), [](auto a, auto b) {
+      return a->second < b->second;
+    });
+    for (auto const match : matches) {
+      bh.fill(bIndex, match->first, bColl);
+      dh.fill(match->second, assns, bIndex, dColl);
     }
   }
   return shared_exception_t();
 }
 
+// 3.
+template <typename ProdA,
+          typename ProdB,
+          typename Data,
+          typename DATACOLL,
+          typename EVENT>
+template <typename Acoll>
+auto
+art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::find_matches(
+  Acoll const& aColl,
+  Assns<ProdA, ProdB, Data> const*& assns,
+  AssnsMatches& matches) const -> shared_exception_t
+{
+  typename EVENT::template HandleT<Assns<ProdA, ProdB, Data>> assnsHandle;
+  event_.getByLabel(assnsTag_, assnsHandle);
+  if (!assnsHandle.isValid()) {
+    return assnsHandle.whyFailed(); // Failed to get Assns product.
+  }
+  assns = &*assnsHandle;
+  matches = match_(aColl, *assns);
+  return shared_exception_t();
+}
+
+////////////////////////////////////////////////////////////////////////
+// Matching, without resolving the associated items, and parallel
+// construction.
+//
+// The associations are matched in two phases:
+//
+// 1. The associations are ordered by the left item, using the index if
+//    there is one (and the reference items are Ptrs), or else by
+//    sorting the (resolved) addresses of the available left items.
+//
+// 2. Each reference item's matching associations are found, as a range
+//    of that order, in which they are in association order.
+//
+// The parallel construction then fills the results in two more:
+//
+// 3. If the results are pointers, each matched right item is resolved
+//    once, so that no Ptr is resolved by two tasks at once.  Any
+//    exception is deferred to phase 4.
+//
+// 4. The results of each reference item are filled by one task, in
+//    association order.
+//
+// With QueryPolicy::parallel, each phase processes its items in
+// chunks, and the exception that the sequential construction would
+// have thrown is the one rethrown.
+////////////////////////////////////////////////////////////////////////
+template <typename ProdA,
+          typename ProdB,
+          typename Data,
+          typename DATACOLL,
+          typename EVENT>
+template <typename Acoll>
+art::detail::AssnsMatches
+art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::match_(
+  Acoll const& aColl,
+  Assns<ProdA, ProdB, Data> const& assns) const
+{
+  using a_item_t = typename Acoll::value_type;
+  std::vector<a_item_t const*> aItems;
+  aItems.reserve(aColl.size());
+  for (auto const& a : aColl) {
+    aItems.push_back(&a);
+  }
+
+  AssnsMatches result;
+  auto& [order, ranges] = result;
+  ranges.resize(aItems.size());
+  if constexpr (std::is_convertible_v<a_item_t, Ptr<ProdA>>) {
+    if (assns.has_index()) {
+      auto const& index = assns.index();
+      auto const entries = index.by_left();
+      order.resize(entries.size());
+      for_each_chunk(entries.size(), policy_, [&](size_t b, size_t const e) {
+        for (; b != e; ++b) {
+          order[b] = entries[b].index;
+        }
+      });
+      for_each_chunk(aItems.size(), policy_, [&](size_t b, size_t const e) {
+        for (; b != e; ++b) {
+          Ptr<ProdA> const& aPtr = *aItems[b];
+          auto const found = index.by_left({aPtr.id(), aPtr.key()});
+          auto const first =
+            static_cast<size_t>(found.data() - entries.data());
+          ranges[b] = {first, first + found.size()};
+        }
+      });
+      return result;
+    }
+  }
+  using a_pointer_t = typename Ptr<ProdA>::const_pointer;
+  std::vector<address_index_t> resolved(assns.size());
+  std::vector<uint8_t> available(assns.size());
+  for_each_chunk(assns.size(), policy_, [&](size_t b, size_t const e) {
+    for (; b != e; ++b) {
+      auto const& aPtr = assns[b].first;
+      available[b] = aPtr.isAvailable();
+      resolved[b] = {available[b] ? aPtr.get() : nullptr, b};
+    }
+  });
+  std::erase_if(resolved, [&available](auto const& item) {
+    return !available[item.second];
+  });
+  sort_by_address(resolved, policy_);
+  order.resize(resolved.size());
+  for_each_chunk(resolved.size(), policy_, [&](size_t b, size_t const e) {
+    for (; b != e; ++b) {
+      order[b] = resolved[b].second;
+    }
+  });
+  for_each_chunk(aItems.size(), policy_, [&](size_t b, size_t const e) {
+    for (; b != e; ++b) {
+      void const* const address = ensurePointer<a_pointer_t>(aItems[b]);
+      auto const [first, last] = std::equal_range(
+        resolved.cbegin(), resolved.cend(), address, CompareAddresses{});
+      ranges[b] = {static_cast<size_t>(first - resolved.cbegin()),
+                   static_cast<size_t>(last - resolved.cbegin())};
+    }
+  });
+  return result;
+}
+
+template <typename ProdA,
+          typename ProdB,
+          typename Data,
+          typename DATACOLL,
+          typename EVENT>
+template <typename Acoll, typename Bcoll>
+void
+art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::
+  fill_in_parallel_(Acoll const& aColl,
+                    Assns<ProdA, ProdB, Data> const& assns,
+                    BcollHelper<ProdB>& bh,
+                    DataCollHelper<Data> const& dh,
+                    Bcoll& bColl,
+                    dataColl_t& dColl) const
+{
+  auto const [order, ranges] = match_(aColl, assns);
+
+  // Phase 3.
+  using b_value_t = typename Bcoll::value_type;
+  if constexpr (std::is_same_v<b_value_t, ProdB const*> ||
+                std::is_same_v<b_value_t, std::vector<ProdB const*>>) {
+    std::vector<std::atomic<bool>> claimed(assns.size());
+    for_each_chunk(ranges.size(), policy_, [&](size_t b, size_t const e) {
+      for (; b != e; ++b) {
+        for (auto i = ranges[b].first; i != ranges[b].second; ++i) {
+          auto const& apair = assns[order[i]];
+          if (claimed[order[i]].exchange(true, std::memory_order_relaxed) ||
+              !apair.first.isAvailable()) {
+            continue;
+          }
+          try {
+            if (apair.second) {
+              apair.second.get();
+            }
+          }
+          catch (...) {
+            // Rethrown in phase 4.
+          }
+        }
+      }
+    });
+  }
+
+  // Phase 4.
+  for_each_chunk(ranges.size(), policy_, [&](size_t b, size_t const e) {
+    for (; b != e; ++b) {
+      for (auto i = ranges[b].first; i != ranges[b].second; ++i) {
+        auto const& apair = assns[order[i]];
+        if (apair.first.isAvailable()) {
+          bh.fill(b, apair.second, bColl);
+          dh.fill(order[i], assns, b, dColl);
+        }
+      }
+    }
+  });
+}
+
 template <typename DATA>
 inline void
 art::detail::DataCollHelper<DATA>::init(size_t const size,
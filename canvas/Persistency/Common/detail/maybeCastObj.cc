@@ -6,9 +6,14 @@
 
 #include <cxxabi.h>
 
-#include <iostream>
-#include <string>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
 #include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace art;
 using namespace std;
@@ -80,72 +85,90 @@ namespace __cxxabiv1 {
 
 namespace {
 
-  class upcast_result {
+  // A step through a virtual base, whose offset within the object is
+  // only known at run time, from the vtable of the subobject holding
+  // it.
+  struct virtual_step {
+    long offset;       // Of the subobject holding the virtual base.
+    long vbase_offset; // Of the virtual base offset, in the vtable.
+    abi::__class_type_info const* base;
+  };
+
+  // How to find the unique public base subobject of a given type,
+  // if any, from the address of an object.
+  class cast_path {
   public:
-    bool first_call = true;
+    bool is_class = true;
     bool found = false;
     bool is_ambiguous = false;
-    long offset = 0L;
+    vector<virtual_step> steps{};
+    long offset = 0L; // From the last virtual base, else the object.
 
-  public:
-    void print [[maybe_unused]] () const;
-    void reset [[maybe_unused]] ();
+    void const*
+    apply(void const* ptr) const
+    {
+      auto address = static_cast<char const*>(ptr);
+      for (auto const& step : steps) {
+        address += step.offset;
+        auto const vtable = *reinterpret_cast<char const* const*>(address);
+        address += *reinterpret_cast<ptrdiff_t const*>(vtable +
+                                                       step.vbase_offset);
+      }
+      return address + offset;
+    }
   };
 
-  void
-  upcast_result::print() const
-  {
-    cout << "       found: " << found << endl;
-    cout << "is_ambiguous: " << is_ambiguous << endl;
-    cout << "      offset: " << offset << endl;
-  }
-
-  void
-  upcast_result::reset()
+  abi::__class_type_info const*
+  last_virtual_base(vector<virtual_step> const& steps)
   {
-    first_call = true;
-    found = false;
-    is_ambiguous = false;
-    offset = 0L;
+    return steps.empty() ? nullptr : steps.back().base;
   }
 
   void
   visit_class_for_upcast(abi::__class_type_info const* ci,
                          abi::__class_type_info const* dest,
+                         vector<virtual_step>& steps,
                          long offset,
-                         upcast_result& res)
+                         bool const first_call,
+                         cast_path& res)
   {
-    if (res.first_call) {
-      res.first_call = false;
-    } else if (ci == dest) {
-      // We found a possible answer.
+    if (!first_call && ci == dest) {
+      // We found a possible answer.  All paths through the same
+      // virtual base lead to the same subobject.
       if (!res.found) {
         res.found = true;
+        res.steps = steps;
         res.offset = offset;
-      } else {
+      } else if (res.offset != offset ||
+                 last_virtual_base(res.steps) != last_virtual_base(steps)) {
         res.is_ambiguous = true;
       }
     }
     // Visit bases, if any.
     if (auto si = dynamic_cast<abi::__si_class_type_info const*>(ci)) {
       // Class is part of a public non-virtual single inheritance chain.
-      visit_class_for_upcast(si->__base_type, dest, offset, res);
+      visit_class_for_upcast(si->__base_type, dest, steps, offset, false, res);
       return;
     }
     if (auto vmi = dynamic_cast<abi::__vmi_class_type_info const*>(ci)) {
       // Class is part of a more complicated inheritance chain.
       for (auto i = 0U; i < vmi->__base_count; ++i) {
         auto const& base = vmi->__base_info[i];
-        bool is_public = false;
-        if (base.__offset_flags & abi::__base_class_type_info::__public_mask) {
-          is_public = true;
+        if (!(base.__offset_flags &
+              abi::__base_class_type_info::__public_mask)) {
+          continue;
         }
         long boff =
           (base.__offset_flags >> abi::__base_class_type_info::__offset_shift);
-        if (is_public && (boff > -1)) {
-          // Base is public access, and boff is not the offset to the
-          // virtual base offset.
-          visit_class_for_upcast(base.__base_type, dest, offset + boff, res);
+        if (base.__offset_flags &
+            abi::__base_class_type_info::__virtual_mask) {
+          // boff is the offset to the virtual base offset.
+          steps.push_back({offset, boff, base.__base_type});
+          visit_class_for_upcast(base.__base_type, dest, steps, 0L, false, res);
+          steps.pop_back();
+        } else {
+          visit_class_for_upcast(
+            base.__base_type, dest, steps, offset + boff, false, res);
         }
       }
       return;
@@ -153,6 +176,70 @@ namespace {
     // Was a leaf class.
   }
 
+  cast_path
+  make_cast_path(type_info const& tid_from, type_info const& tid_to)
+  {
+    cast_path res;
+    auto ci_from = dynamic_cast<abi::__class_type_info const*>(&tid_from);
+    auto ci_to = dynamic_cast<abi::__class_type_info const*>(&tid_to);
+    if (ci_from == nullptr || ci_to == nullptr) {
+      // Not a class, done.
+      res.is_class = false;
+      return res;
+    }
+    if (ci_from == ci_to) {
+      // Trivial, same types, nothing to do.
+      res.found = true;
+      return res;
+    }
+    vector<virtual_step> steps;
+    visit_class_for_upcast(ci_from, ci_to, steps, 0L, true, res);
+    return res;
+  }
+
+  using type_pair = pair<type_info const*, type_info const*>;
+
+  struct type_pair_hash {
+    size_t
+    operator()(type_pair const& types) const noexcept
+    {
+      hash<type_info const*> const h;
+      return h(types.first) ^ (h(types.second) << 1);
+    }
+  };
+
+  // The inheritance graph is walked once per pair of types; casts
+  // then cost a lookup, which is usually of the same pair as the
+  // previous cast on the same thread.
+  cast_path const&
+  find_cast_path(type_info const& tid_from, type_info const& tid_to)
+  {
+    thread_local type_pair last_types{nullptr, nullptr};
+    thread_local cast_path const* last_path{nullptr};
+    type_pair const types{&tid_from, &tid_to};
+    if (types == last_types) {
+      return *last_path;
+    }
+
+    static shared_mutex mutex;
+    static unordered_map<type_pair, cast_path, type_pair_hash> paths;
+    cast_path const* path{nullptr};
+    {
+      shared_lock lock{mutex};
+      if (auto it = paths.find(types); it != paths.cend()) {
+        path = &it->second;
+      }
+    }
+    if (path == nullptr) {
+      auto new_path = make_cast_path(tid_from, tid_to);
+      unique_lock lock{mutex};
+      path = &paths.try_emplace(types, move(new_path)).first->second;
+    }
+    last_types = types;
+    last_path = path;
+    return *path;
+  }
+
 } // unnamed namespace
 
 bool
@@ -162,23 +249,8 @@ detail::upcastAllowed(type_info const& tid_from, type_info const& tid_to)
     // Trivial, nothing to do.
     return true;
   }
-  auto ci_from = dynamic_cast<abi::__class_type_info const*>(&tid_from);
-  auto ci_to = dynamic_cast<abi::__class_type_info const*>(&tid_to);
-  if (ci_from == nullptr) {
-    // Not a class, done.
-    return false;
-  }
-  if (ci_to == nullptr) {
-    // Not a class, done.
-    return false;
-  }
-  if (ci_from == ci_to) {
-    // Trivial, same types, nothing to do.
-    return true;
-  }
-  upcast_result res;
-  visit_class_for_upcast(ci_from, ci_to, 0L, res);
-  return res.found && !res.is_ambiguous;
+  auto const& path = find_cast_path(tid_from, tid_to);
+  return path.is_class && path.found && !path.is_ambiguous;
 }
 
 void const*
@@ -190,35 +262,27 @@ detail::maybeCastObj(void const* ptr,
     // Trivial, nothing to do.
     return ptr;
   }
-  auto ci_from = dynamic_cast<abi::__class_type_info const*>(&tid_from);
-  auto ci_to = dynamic_cast<abi::__class_type_info const*>(&tid_to);
-  if (ci_from == nullptr) {
-    // Not a class, done.
-    return ptr;
-  }
-  if (ci_to == nullptr) {
+  auto const& path = find_cast_path(tid_from, tid_to);
+  if (!path.is_class) {
     // Not a class, done.
     return ptr;
   }
-  if (ci_from == ci_to) {
-    // Trivial, same types, nothing to do.
-    return ptr;
-  }
-  upcast_result res;
-  visit_class_for_upcast(ci_from, ci_to, 0L, res);
-  if (!res.found) {
+  if (!path.found) {
     throw Exception(errors::TypeConversion)
       << "maybeCastObj : unable to convert type: "
       << cet::demangle_symbol(tid_from.name())
       << "\nto: " << cet::demangle_symbol(tid_to.name()) << "\n"
       << "No suitable base found.\n";
   }
-  if (res.is_ambiguous) {
+  if (path.is_ambiguous) {
     throw Exception(errors::TypeConversion)
       << "MaybeCastObj : unable to convert type: "
       << cet::demangle_symbol(tid_from.name())
       << "\nto: " << cet::demangle_symbol(tid_to.name()) << "\n"
       << "Base class is ambiguous.\n";
   }
-  return static_cast<char const*>(ptr) + res.offset;
+  if (ptr == nullptr) {
+    return ptr;
+  }
+  return path.apply(ptr);
 }
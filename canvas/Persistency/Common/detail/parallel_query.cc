@@ -0,0 +1,69 @@
+#include "canvas/Persistency/Common/detail/parallel_query.h"
+// vim: set sw=2:
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+
+namespace {
+  bool
+  by_address(art::detail::address_index_t const& a,
+             art::detail::address_index_t const& b)
+  {
+    if (a.first != b.first) {
+      return std::less<void const*>{}(a.first, b.first);
+    }
+    return a.second < b.second;
+  }
+}
+
+void
+art::detail::for_each_chunk(
+  std::size_t const n,
+  QueryPolicy const policy,
+  std::function<void(std::size_t, std::size_t)> const& body)
+{
+  if (policy == QueryPolicy::sequential) {
+    body(0, n);
+    return;
+  }
+  std::mutex m;
+  std::size_t first_failure{std::numeric_limits<std::size_t>::max()};
+  std::exception_ptr exception;
+  // Exceptions are caught here rather than propagated by TBB, which
+  // would cancel the remaining chunks and rethrow whichever exception
+  // happened to be caught first.
+  tbb::parallel_for(tbb::blocked_range<std::size_t>{0, n},
+                    [&](tbb::blocked_range<std::size_t> const& r) {
+                      try {
+                        body(r.begin(), r.end());
+                      }
+                      catch (...) {
+                        std::lock_guard sentry{m};
+                        if (r.begin() < first_failure) {
+                          first_failure = r.begin();
+                          exception = std::current_exception();
+                        }
+                      }
+                    });
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void
+art::detail::sort_by_address(std::vector<address_index_t>& items,
+                             QueryPolicy const policy)
+{
+  if (policy == QueryPolicy::sequential) {
+    std::sort(items.begin(), items.end(), by_address);
+  } else {
+    tbb::parallel_sort(items.begin(), items.end(), by_address);
+  }
+}
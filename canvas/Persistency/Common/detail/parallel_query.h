@@ -0,0 +1,60 @@
+#ifndef canvas_Persistency_Common_detail_parallel_query_h
+#define canvas_Persistency_Common_detail_parallel_query_h
+// vim: set sw=2:
+
+// ======================================================================
+//
+// Building blocks for the construction of the smart query objects
+// (see IPRHelper.h), which run in parallel for QueryPolicy::parallel.
+// They are not templates, so that TBB remains a private dependency of
+// canvas.
+//
+// ======================================================================
+
+#include "canvas/Persistency/Common/QueryPolicy.h"
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace art::detail {
+
+  // Invokes body(0, n) for QueryPolicy::sequential.  Otherwise,
+  // invokes body(begin, end) for disjoint chunks [begin, end) covering
+  // [0, n), concurrently, returning when all have completed.  If any
+  // invocations throw, the exception thrown by the one with the lowest
+  // begin is rethrown; as each invocation is expected to process its
+  // chunk in order, this is the exception a sequential loop over [0, n)
+  // would have thrown.
+  void for_each_chunk(
+    std::size_t n,
+    QueryPolicy policy,
+    std::function<void(std::size_t begin, std::size_t end)> const& body);
+
+  // Sorts by address and then by index.
+  using address_index_t = std::pair<void const*, std::size_t>;
+  void sort_by_address(std::vector<address_index_t>& items,
+                       QueryPolicy policy);
+
+  // For searching items so sorted by address alone.
+  struct CompareAddresses {
+    bool
+    operator()(address_index_t const& a, void const* const b) const noexcept
+    {
+      return std::less<void const*>{}(a.first, b);
+    }
+    bool
+    operator()(void const* const a, address_index_t const& b) const noexcept
+    {
+      return std::less<void const*>{}(a, b.first);
+    }
+  };
+
+} // namespace art::detail
+
+#endif /* canvas_Persistency_Common_detail_parallel_query_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -14,6 +14,8 @@ namespace art {
     class AssnsBase;
   }
 
+  template <typename T>
+  class CompactPtrVector;
   class EDProduct;
   class EDProductGetter;
   class GroupQueryResult;
@@ -0,0 +1,71 @@
+#include "canvas/Persistency/Common/resolve.h"
+// vim: set sw=2 expandtab :
+
+#include "canvas/Persistency/Common/EDProduct.h"
+#include "canvas/Persistency/Common/EDProductGetter.h"
+#include "canvas/Utilities/Exception.h"
+#include "cetlib_except/demangle.h"
+
+using art::detail::PtrBatches;
+
+void
+PtrBatches::add(RefCore const& core,
+                std::size_t const key,
+                std::size_t const position)
+{
+  // Ptrs to the same product usually come together.
+  if (current_ == batches_.size() || batches_[current_].id != core.id()) {
+    auto const [it, inserted] =
+      indices_.try_emplace(core.id(), batches_.size());
+    if (inserted) {
+      batches_.push_back(Batch{core.id(), core.productGetter()});
+    }
+    current_ = it->second;
+  }
+  auto& batch = batches_[current_];
+  if (batch.getter == nullptr) {
+    batch.getter = core.productGetter();
+  }
+  batch.keys.push_back(key);
+  batch.positions.push_back(position);
+}
+
+void
+PtrBatches::resolve(std::type_info const& type,
+                    std::vector<void const*>& addresses) const
+{
+  // Let the products be read concurrently, where possible.
+  if (batches_.size() > 1) {
+    for (auto const& batch : batches_) {
+      if (batch.getter) {
+        batch.getter->prefetch();
+      }
+    }
+  }
+  for (auto const& batch : batches_) {
+    EDProduct const* product{nullptr};
+    if (batch.getter) {
+      product = batch.getter->getIt();
+    }
+    if (product == nullptr) {
+      Exception e(errors::ProductNotFound);
+      e << "A request to resolve an Ptr to a product containing items of "
+           "type: "
+        << cet::demangle_symbol(type.name()) << " with ProductID "
+        << batch.id
+        << "\ncannot be satisfied because the product cannot be found.\n";
+      if (batch.getter == nullptr) {
+        e << "The productGetter was not set -- are you trying to "
+             "dereference a Ptr during mixing?\n";
+      } else {
+        e << "Probably the branch containing the product is not stored in "
+             "the input file.\n";
+      }
+      throw e;
+    }
+    auto const found = product->getElementAddresses(type, batch.keys);
+    for (std::size_t i{}; i != found.size(); ++i) {
+      addresses[batch.positions[i]] = found[i];
+    }
+  }
+}
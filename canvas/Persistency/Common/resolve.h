@@ -0,0 +1,112 @@
+#ifndef canvas_Persistency_Common_resolve_h
+#define canvas_Persistency_Common_resolve_h
+// vim: set sw=2 expandtab :
+
+//
+//  resolve: find the items referred to by a sequence of Ptrs.
+//
+//  template <typename T>
+//  void resolve(std::span<Ptr<T> const> ptrs,
+//               std::vector<T const*>& items);
+//
+//  On return, items[i] == ptrs[i].get() for each i, as if each Ptr had
+//  been dereferenced in turn, and the Ptrs are resolved.  Unresolved
+//  Ptrs are grouped by ProductID, so that each product is obtained
+//  from its EDProductGetter once and the addresses of all of its
+//  wanted items are found with a single call to
+//  EDProduct::getElementAddresses.  When the Ptrs span several
+//  products, all of them are prefetched (see EDProductGetter.h) before
+//  the first is obtained.
+//
+//  As for Ptr::get(), an exception is thrown if the product of a
+//  non-null Ptr cannot be found or does not support Ptrs, and the
+//  Ptrs must not be resolved concurrently by another thread.
+//
+
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/RefCore.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <cstddef>
+#include <span>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace art {
+
+  class EDProductGetter;
+
+  template <typename T>
+  void resolve(std::span<Ptr<T> const> ptrs, std::vector<T const*>& items);
+
+  template <typename T>
+  void
+  resolve(std::vector<Ptr<T>> const& ptrs, std::vector<T const*>& items)
+  {
+    resolve(std::span<Ptr<T> const>{ptrs}, items);
+  }
+
+  namespace detail {
+
+    // The Ptrs to be resolved, grouped by product.
+    class PtrBatches {
+    public:
+      void add(RefCore const& core, std::size_t key, std::size_t position);
+
+      // Sets addresses[position] for each added Ptr.
+      void resolve(std::type_info const& type,
+                   std::vector<void const*>& addresses) const;
+
+    private:
+      struct Batch {
+        ProductID id;
+        EDProductGetter const* getter;
+        std::vector<unsigned long> keys{};
+        std::vector<std::size_t> positions{};
+      };
+
+      std::vector<Batch> batches_{};
+      std::unordered_map<ProductID, std::size_t> indices_{};
+      std::size_t current_{};
+    };
+
+  } // namespace detail
+
+} // namespace art
+
+template <typename T>
+void
+art::resolve(std::span<Ptr<T> const> const ptrs, std::vector<T const*>& items)
+{
+  std::vector<void const*> addresses(ptrs.size());
+  detail::PtrBatches batches;
+  for (std::size_t i{}; i != ptrs.size(); ++i) {
+    auto const& ptr = ptrs[i];
+    if (ptr.isNull()) {
+      continue;
+    }
+    auto const& core = ptr.refCore();
+    if (core.productPtr() != nullptr) {
+      addresses[i] = core.productPtr();
+    } else {
+      batches.add(core, ptr.key(), i);
+    }
+  }
+  batches.resolve(typeid(T), addresses);
+
+  items.resize(ptrs.size());
+  for (std::size_t i{}; i != ptrs.size(); ++i) {
+    auto const& ptr = ptrs[i];
+    if (ptr.isNonnull() && ptr.refCore().productPtr() == nullptr) {
+      ptr.refCore().setProductPtr(addresses[i]);
+    }
+    items[i] = reinterpret_cast<T const*>(addresses[i]);
+  }
+}
+
+#endif /* canvas_Persistency_Common_resolve_h */
+
+// Local Variables:
+// mode: c++
+// End:
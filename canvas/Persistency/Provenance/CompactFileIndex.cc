@@ -0,0 +1,458 @@
+#include "canvas/Persistency/Provenance/CompactFileIndex.h"
+// vim: set sw=2 expandtab :
+
+#include "canvas/Persistency/Provenance/RunID.h"
+#include "canvas/Persistency/Provenance/SortInvalidFirst.h"
+#include "canvas/Persistency/Provenance/SubRunID.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+using namespace std;
+
+namespace {
+  constexpr std::uint32_t magic{0x58444946}; // "FIDX"
+  constexpr std::uint32_t version{1};
+
+  constexpr art::SortInvalidFirst<std::uint32_t> invalidFirst{-1u};
+
+  bool
+  subRunUnspecified(art::EventID const& eID)
+  {
+    // See FileIndex.cc.
+    return (!eID.isValid()) && eID.runID().isValid() &&
+           art::EventID(art::SubRunID::firstSubRun(), eID.event()).isValid();
+  }
+
+  constexpr std::size_t
+  padded(std::size_t const nBytes)
+  {
+    return (nBytes + 7) & ~std::size_t{7};
+  }
+} // unnamed namespace
+
+namespace art {
+
+  CompactFileIndex::CompactFileIndex(FileIndex const& fileIndex)
+  {
+    if (!is_sorted(fileIndex.cbegin(), fileIndex.cend())) {
+      throw Exception(errors::LogicError)
+        << "CompactFileIndex requires a FileIndex sorted by run, subrun, "
+           "and event number.\n";
+    }
+
+    vector<Block> runs;
+    vector<Block> subRuns;
+    std::uint64_t pos{};
+    for (auto const& e : fileIndex) {
+      auto const& id = e.eventID;
+      bool const newRun = runs.empty() || runs.back().number != id.run();
+      if (newRun) {
+        runs.push_back({pos, id.run(), 0});
+      }
+      if (newRun || subRuns.back().number != id.subRun()) {
+        subRuns.push_back({pos, id.subRun(), 0});
+      }
+      ++pos;
+    }
+
+    auto const nEntries = fileIndex.size();
+    auto const nBytes = sizeof(Header) +
+                        sizeof(Block) * (runs.size() + subRuns.size()) +
+                        sizeof(std::int64_t) * nEntries +
+                        padded(sizeof(std::uint32_t) * nEntries);
+    storage_.resize(nBytes / sizeof(std::uint64_t));
+
+    auto p = reinterpret_cast<char*>(storage_.data());
+    Header const header{magic, version, nEntries, runs.size(), subRuns.size()};
+    memcpy(p, &header, sizeof(Header));
+    p += sizeof(Header);
+    memcpy(p, runs.data(), sizeof(Block) * runs.size());
+    p += sizeof(Block) * runs.size();
+    memcpy(p, subRuns.data(), sizeof(Block) * subRuns.size());
+    p += sizeof(Block) * subRuns.size();
+    auto entries = reinterpret_cast<std::int64_t*>(p);
+    auto events = reinterpret_cast<std::uint32_t*>(entries + nEntries);
+    for (auto const& e : fileIndex) {
+      *entries++ = e.entry;
+      *events++ = e.eventID.event();
+    }
+    bind(storage_.data(), nBytes);
+  }
+
+  CompactFileIndex::CompactFileIndex(void const* data, size_type const nBytes)
+  {
+    bind(data, nBytes);
+  }
+
+  CompactFileIndex::CompactFileIndex(CompactFileIndex const& other)
+    : storage_{other.storage_}
+  {
+    bind(storage_.empty() ? other.data() : storage_.data(), other.nBytes_);
+  }
+
+  CompactFileIndex::CompactFileIndex(CompactFileIndex&& other) noexcept
+    : storage_{std::move(other.storage_)}
+    , header_{other.header_}
+    , runs_{other.runs_}
+    , subRuns_{other.subRuns_}
+    , entries_{other.entries_}
+    , events_{other.events_}
+    , nBytes_{other.nBytes_}
+  {
+    // Moving the vector does not relocate its buffer, so the pointers
+    // remain valid.
+  }
+
+  CompactFileIndex&
+  CompactFileIndex::operator=(CompactFileIndex const& other)
+  {
+    if (this != &other) {
+      CompactFileIndex tmp{other};
+      *this = std::move(tmp);
+    }
+    return *this;
+  }
+
+  CompactFileIndex&
+  CompactFileIndex::operator=(CompactFileIndex&& other) noexcept
+  {
+    storage_ = std::move(other.storage_);
+    header_ = other.header_;
+    runs_ = other.runs_;
+    subRuns_ = other.subRuns_;
+    entries_ = other.entries_;
+    events_ = other.events_;
+    nBytes_ = other.nBytes_;
+    return *this;
+  }
+
+  void
+  CompactFileIndex::bind(void const* const data, size_type const nBytes)
+  {
+    static_assert(sizeof(Header) == 32);
+    static_assert(sizeof(Block) == 16);
+    if (reinterpret_cast<std::uintptr_t>(data) % alignof(std::uint64_t) !=
+        0) {
+      throw Exception(errors::LogicError)
+        << "CompactFileIndex data must be 8-byte aligned.\n";
+    }
+    auto p = static_cast<char const*>(data);
+    auto const header = reinterpret_cast<Header const*>(p);
+    if (nBytes < sizeof(Header) || header->magic != magic ||
+        header->version != version) {
+      throw Exception(errors::DataCorruption)
+        << "CompactFileIndex data has an unrecognized header.\n";
+    }
+    auto const nEntries = header->nEntries;
+    auto const expected =
+      sizeof(Header) + sizeof(Block) * (header->nRuns + header->nSubRuns) +
+      sizeof(std::int64_t) * nEntries +
+      padded(sizeof(std::uint32_t) * nEntries);
+    if (nBytes != expected) {
+      throw Exception(errors::DataCorruption)
+        << "CompactFileIndex data has size " << nBytes << " but "
+        << expected << " bytes were expected.\n";
+    }
+    header_ = header;
+    p += sizeof(Header);
+    runs_ = reinterpret_cast<Block const*>(p);
+    subRuns_ = runs_ + header->nRuns;
+    entries_ = reinterpret_cast<std::int64_t const*>(subRuns_ +
+                                                      header->nSubRuns);
+    events_ = reinterpret_cast<std::uint32_t const*>(entries_ + nEntries);
+    nBytes_ = nBytes;
+  }
+
+  void const*
+  CompactFileIndex::data() const noexcept
+  {
+    return header_;
+  }
+
+  CompactFileIndex::size_type
+  CompactFileIndex::data_size() const noexcept
+  {
+    return nBytes_;
+  }
+
+  CompactFileIndex::size_type
+  CompactFileIndex::size() const noexcept
+  {
+    return header_->nEntries;
+  }
+
+  bool
+  CompactFileIndex::empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  FileIndex::Element
+  CompactFileIndex::operator[](size_type const i) const
+  {
+    auto const run = prev(upper_bound(runs_,
+                                      runs_ + header_->nRuns,
+                                      i,
+                                      [](size_type const pos, Block const& b) {
+                                        return pos < b.begin;
+                                      }));
+    auto const subRun =
+      prev(upper_bound(subRuns_,
+                       subRuns_ + header_->nSubRuns,
+                       i,
+                       [](size_type const pos, Block const& b) {
+                         return pos < b.begin;
+                       }));
+    return {EventID{run->number, subRun->number, events_[i]}, entries_[i]};
+  }
+
+  FileIndex::EntryType
+  CompactFileIndex::getEntryType(size_type const i) const
+  {
+    if (events_[i] != IDNumber<Level::Event>::invalid()) {
+      return FileIndex::kEvent;
+    }
+    auto const subRun =
+      prev(upper_bound(subRuns_,
+                       subRuns_ + header_->nSubRuns,
+                       i,
+                       [](size_type const pos, Block const& b) {
+                         return pos < b.begin;
+                       }));
+    return subRun->number != IDNumber<Level::SubRun>::invalid() ?
+             FileIndex::kSubRun :
+             FileIndex::kRun;
+  }
+
+  void
+  CompactFileIndex::const_iterator::seek() noexcept
+  {
+    auto const header = index_->header_;
+    auto const blockOf = [this](Block const* const first,
+                                std::uint64_t const n) {
+      auto const it = upper_bound(
+        first, first + n, pos_, [](size_type const pos, Block const& b) {
+          return pos < b.begin;
+        });
+      return it == first ? first : prev(it);
+    };
+    run_ = blockOf(index_->runs_, header->nRuns);
+    subRun_ = blockOf(index_->subRuns_, header->nSubRuns);
+  }
+
+  CompactFileIndex::const_iterator
+  CompactFileIndex::begin() const
+  {
+    return {this, 0};
+  }
+
+  CompactFileIndex::const_iterator
+  CompactFileIndex::cbegin() const
+  {
+    return begin();
+  }
+
+  CompactFileIndex::const_iterator
+  CompactFileIndex::end() const
+  {
+    return {this, size()};
+  }
+
+  CompactFileIndex::const_iterator
+  CompactFileIndex::cend() const
+  {
+    return end();
+  }
+
+  // Equivalent to a lower-bound search over the run-, subrun-, and
+  // event-ordered elements, but descending through the run and subrun
+  // blocks before searching the event column.
+  CompactFileIndex::size_type
+  CompactFileIndex::lowerBound(RunNumber_t const r,
+                               SubRunNumber_t const sr,
+                               EventNumber_t const e) const
+  {
+    auto const n = size();
+    auto const runsEnd = runs_ + header_->nRuns;
+    auto const run =
+      lower_bound(runs_, runsEnd, r, [](Block const& b, std::uint32_t v) {
+        return invalidFirst(b.number, v);
+      });
+    if (run == runsEnd) {
+      return n;
+    }
+    if (run->number != r) {
+      return run->begin;
+    }
+    auto const runEnd = next(run) == runsEnd ? n : next(run)->begin;
+
+    auto const byBegin = [](Block const& b, std::uint64_t const pos) {
+      return b.begin < pos;
+    };
+    auto const subRunsEnd = subRuns_ + header_->nSubRuns;
+    auto const first = lower_bound(subRuns_, subRunsEnd, run->begin, byBegin);
+    auto const last = lower_bound(first, subRunsEnd, runEnd, byBegin);
+    auto const subRun =
+      lower_bound(first, last, sr, [](Block const& b, std::uint32_t v) {
+        return invalidFirst(b.number, v);
+      });
+    if (subRun == last) {
+      return runEnd;
+    }
+    if (subRun->number != sr) {
+      return subRun->begin;
+    }
+    auto const subRunEnd = next(subRun) == subRunsEnd ? n : next(subRun)->begin;
+    return lower_bound(
+             events_ + subRun->begin, events_ + subRunEnd, e, invalidFirst) -
+           events_;
+  }
+
+  CompactFileIndex::size_type
+  CompactFileIndex::skipTo(size_type const pos,
+                           FileIndex::EntryType const type) const
+  {
+    auto it = const_iterator{this, pos};
+    auto const e = end();
+    while (it != e && (*it).getEntryType() != type) {
+      ++it;
+    }
+    return it.position();
+  }
+
+  CompactFileIndex::const_iterator
+  CompactFileIndex::findPosition(EventID const& eID) const
+  {
+    return {this, lowerBound(eID.run(), eID.subRun(), eID.event())};
+  }
+
+  CompactFileIndex::const_iterator
+  CompactFileIndex::findPosition(EventID const& eID, bool const exact) const
+  {
+    if (subRunUnspecified(eID)) {
+      return findEventForUnspecifiedSubRun(eID, exact);
+    }
+    auto const pos = skipTo(findPosition(eID).position(), FileIndex::kEvent);
+    if (pos == size()) {
+      return end();
+    }
+    if (exact && (*this)[pos].eventID != eID) {
+      return end();
+    }
+    return {this, pos};
+  }
+
+  CompactFileIndex::const_iterator
+  CompactFileIndex::findPosition(SubRunID const& srID, bool const exact) const
+  {
+    auto const pos = skipTo(findPosition(EventID::invalidEvent(srID)).position(),
+                            FileIndex::kSubRun);
+    if (pos == size()) {
+      return end();
+    }
+    if (exact && (*this)[pos].eventID.subRunID() != srID) {
+      return end();
+    }
+    return {this, pos};
+  }
+
+  CompactFileIndex::const_iterator
+  CompactFileIndex::findPosition(RunID const& rID, bool const exact) const
+  {
+    auto const pos = skipTo(findPosition(EventID::invalidEvent(rID)).position(),
+                            FileIndex::kRun);
+    if (pos == size()) {
+      return end();
+    }
+    if (exact && (*this)[pos].eventID.runID() != rID) {
+      return end();
+    }
+    return {this, pos};
+  }
+
+  CompactFileIndex::const_iterator
+  CompactFileIndex::findSubRunOrRunPosition(SubRunID const& srID) const
+  {
+    auto it = findPosition(EventID::invalidEvent(srID));
+    auto const e = end();
+    while (it != e && (*it).getEntryType() == FileIndex::kEvent) {
+      ++it;
+    }
+    return it;
+  }
+
+  CompactFileIndex::const_iterator
+  CompactFileIndex::findEventForUnspecifiedSubRun(EventID const& eID,
+                                                  bool) const
+  {
+    auto const runsEnd = runs_ + header_->nRuns;
+    auto const run = lower_bound(
+      runs_, runsEnd, eID.run(), [](Block const& b, std::uint32_t v) {
+        return invalidFirst(b.number, v);
+      });
+    if (run == runsEnd || run->number != eID.run()) {
+      return end();
+    }
+    auto const n = size();
+    auto const runEnd = next(run) == runsEnd ? n : next(run)->begin;
+    auto const subRunsEnd = subRuns_ + header_->nSubRuns;
+    auto subRun = lower_bound(
+      subRuns_, subRunsEnd, run->begin, [](Block const& b, std::uint64_t pos) {
+        return b.begin < pos;
+      });
+    for (; subRun != subRunsEnd && subRun->begin < runEnd; ++subRun) {
+      auto const b = events_ + subRun->begin;
+      auto const e = events_ + (next(subRun) == subRunsEnd ?
+                                  n :
+                                  next(subRun)->begin);
+      auto const it = lower_bound(b, e, eID.event(), invalidFirst);
+      if (it != e && *it == eID.event()) {
+        return {this, static_cast<size_type>(it - events_)};
+      }
+    }
+    return end();
+  }
+
+  bool
+  CompactFileIndex::contains(EventID const& id, bool const exact) const
+  {
+    return findPosition(id, exact) != end();
+  }
+
+  bool
+  CompactFileIndex::contains(SubRunID const& id, bool const exact) const
+  {
+    return findPosition(id, exact) != end();
+  }
+
+  bool
+  CompactFileIndex::contains(RunID const& id, bool const exact) const
+  {
+    return findPosition(id, exact) != end();
+  }
+
+  FileIndex
+  CompactFileIndex::toFileIndex() const
+  {
+    FileIndex result;
+    auto const n = size();
+    auto const runsEnd = runs_ + header_->nRuns;
+    auto const subRunsEnd = subRuns_ + header_->nSubRuns;
+    auto run = runs_;
+    for (auto subRun = subRuns_; subRun != subRunsEnd; ++subRun) {
+      while (next(run) != runsEnd && next(run)->begin <= subRun->begin) {
+        ++run;
+      }
+      auto const last = next(subRun) == subRunsEnd ? n : next(subRun)->begin;
+      for (auto i = subRun->begin; i != last; ++i) {
+        result.addEntryOnLoad(EventID{run->number, subRun->number, events_[i]},
+                              entries_[i]);
+      }
+    }
+    return result;
+  }
+
+} // namespace art
@@ -0,0 +1,297 @@
+#ifndef canvas_Persistency_Provenance_CompactFileIndex_h
+#define canvas_Persistency_Provenance_CompactFileIndex_h
+// vim: set sw=2 expandtab :
+
+////////////////////////////////////////////////////////////////////////
+//
+// CompactFileIndex: a read-only, column-oriented representation of a
+// FileIndex sorted by run, subrun, and event number.
+//
+// The run and subrun numbers are run-length encoded, and the event
+// and entry numbers are stored in separate columns, for about 12 bytes
+// per entry instead of the 24 of a FileIndex::Element.  The whole
+// representation is one flat, relocatable block of memory that may be
+// written out as-is (data(), data_size()) and later viewed in place,
+// e.g. from a read-only memory mapping, without any deserialization.
+//
+// The blob layout, in native byte order, is:
+//
+//   Header                     (32 bytes)
+//   Block runs[nRuns]          (16 bytes each)
+//   Block subRuns[nSubRuns]    (16 bytes each)
+//   int64 entries[nEntries]
+//   uint32 events[nEntries]
+//
+// where each Block records an ID number and the position of the
+// first entry having it.  SubRun blocks never span more than one run.
+//
+// The interface mirrors that of FileIndex: iterators yield
+// FileIndex::Element by value, and the findPosition() overloads
+// return the same positions as those of a FileIndex sorted with
+// sortBy_Run_SubRun_Event().  The one exception is the lookup of an
+// event with an unspecified subrun, which always returns the matching
+// event with the lowest subrun number.
+//
+// Iterators track the run and subrun blocks of their position, so
+// that stepping through the elements costs constant time per element;
+// operator[] and iterator jumps search the blocks instead.
+//
+// A FileIndex constructed from a CompactFileIndex uses it as its
+// backing store until its entries are first needed; viewing a blob
+// thus yields a usable FileIndex without building any Elements.
+// toFileIndex() instead builds the entries immediately.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Persistency/Provenance/FileIndex.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace art {
+
+  class CompactFileIndex {
+  public:
+    using EntryNumber_t = FileIndex::EntryNumber_t;
+    using size_type = std::size_t;
+    class const_iterator;
+
+    // Build an owning representation.  Throws if the FileIndex is
+    // not sorted by run, subrun, and event number.
+    explicit CompactFileIndex(FileIndex const& fileIndex);
+
+    // Non-owning view of a blob previously obtained from data().  The
+    // memory must be 8-byte aligned and must outlive this object.
+    CompactFileIndex(void const* data, size_type nBytes);
+
+    CompactFileIndex(CompactFileIndex const& other);
+    CompactFileIndex(CompactFileIndex&& other) noexcept;
+    CompactFileIndex& operator=(CompactFileIndex const& other);
+    CompactFileIndex& operator=(CompactFileIndex&& other) noexcept;
+
+    // The serialized representation.
+    void const* data() const noexcept;
+    size_type data_size() const noexcept;
+
+    size_type size() const noexcept;
+    bool empty() const noexcept;
+
+    FileIndex::Element operator[](size_type i) const;
+    FileIndex::EntryType getEntryType(size_type i) const;
+
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    const_iterator end() const;
+    const_iterator cend() const;
+
+    const_iterator findPosition(EventID const& eID) const;
+    const_iterator findPosition(EventID const& eID, bool exact) const;
+    const_iterator findPosition(SubRunID const& srID, bool exact) const;
+    const_iterator findPosition(RunID const& rID, bool exact) const;
+
+    const_iterator findSubRunOrRunPosition(SubRunID const& srID) const;
+
+    bool contains(EventID const& id, bool exact) const;
+    bool contains(SubRunID const& id, bool exact) const;
+    bool contains(RunID const& id, bool exact) const;
+
+    // Materialize the equivalent FileIndex.
+    FileIndex toFileIndex() const;
+
+  private:
+    struct Header {
+      std::uint32_t magic;
+      std::uint32_t version;
+      std::uint64_t nEntries;
+      std::uint64_t nRuns;
+      std::uint64_t nSubRuns;
+    };
+
+    struct Block {
+      std::uint64_t begin;
+      std::uint32_t number;
+      std::uint32_t padding;
+    };
+
+    void bind(void const* data, size_type nBytes);
+    size_type lowerBound(RunNumber_t r,
+                         SubRunNumber_t sr,
+                         EventNumber_t e) const;
+    size_type skipTo(size_type pos, FileIndex::EntryType type) const;
+    const_iterator findEventForUnspecifiedSubRun(EventID const& eID,
+                                                 bool exact) const;
+
+    // Backing store when owning, 8-byte aligned.
+    std::vector<std::uint64_t> storage_{};
+
+    Header const* header_{nullptr};
+    Block const* runs_{nullptr};
+    Block const* subRuns_{nullptr};
+    std::int64_t const* entries_{nullptr};
+    std::uint32_t const* events_{nullptr};
+    size_type nBytes_{};
+  };
+
+  // Random-access iterator yielding elements by value.  Incrementing
+  // and decrementing move the cached run and subrun blocks along with
+  // the position; other moves search for them.
+  class CompactFileIndex::const_iterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = FileIndex::Element;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = FileIndex::Element;
+
+    const_iterator() = default;
+
+    reference
+    operator*() const
+    {
+      return {EventID{run_->number, subRun_->number, index_->events_[pos_]},
+              index_->entries_[pos_]};
+    }
+    reference
+    operator[](difference_type const n) const
+    {
+      return *(*this + n);
+    }
+    size_type
+    position() const noexcept
+    {
+      return pos_;
+    }
+
+    const_iterator&
+    operator++() noexcept
+    {
+      ++pos_;
+      auto const header = index_->header_;
+      if (subRun_ + 1 != index_->subRuns_ + header->nSubRuns &&
+          subRun_[1].begin == pos_) {
+        ++subRun_;
+        if (run_ + 1 != index_->runs_ + header->nRuns &&
+            run_[1].begin == pos_) {
+          ++run_;
+        }
+      }
+      return *this;
+    }
+    const_iterator
+    operator++(int) noexcept
+    {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    const_iterator&
+    operator--() noexcept
+    {
+      auto const pos = pos_--;
+      if (subRun_->begin == pos) {
+        --subRun_;
+        if (run_->begin == pos) {
+          --run_;
+        }
+      }
+      return *this;
+    }
+    const_iterator
+    operator--(int) noexcept
+    {
+      auto tmp = *this;
+      --*this;
+      return tmp;
+    }
+    const_iterator&
+    operator+=(difference_type const n) noexcept
+    {
+      pos_ += n;
+      seek();
+      return *this;
+    }
+    const_iterator&
+    operator-=(difference_type const n) noexcept
+    {
+      pos_ -= n;
+      seek();
+      return *this;
+    }
+    friend const_iterator
+    operator+(const_iterator it, difference_type const n) noexcept
+    {
+      return it += n;
+    }
+    friend const_iterator
+    operator+(difference_type const n, const_iterator it) noexcept
+    {
+      return it += n;
+    }
+    friend const_iterator
+    operator-(const_iterator it, difference_type const n) noexcept
+    {
+      return it -= n;
+    }
+    friend difference_type
+    operator-(const_iterator const& a, const_iterator const& b) noexcept
+    {
+      return static_cast<difference_type>(a.pos_) -
+             static_cast<difference_type>(b.pos_);
+    }
+    friend bool
+    operator==(const_iterator const& a, const_iterator const& b) noexcept
+    {
+      return a.pos_ == b.pos_;
+    }
+    friend bool
+    operator!=(const_iterator const& a, const_iterator const& b) noexcept
+    {
+      return !(a == b);
+    }
+    friend bool
+    operator<(const_iterator const& a, const_iterator const& b) noexcept
+    {
+      return a.pos_ < b.pos_;
+    }
+    friend bool
+    operator>(const_iterator const& a, const_iterator const& b) noexcept
+    {
+      return b < a;
+    }
+    friend bool
+    operator<=(const_iterator const& a, const_iterator const& b) noexcept
+    {
+      return !(b < a);
+    }
+    friend bool
+    operator>=(const_iterator const& a, const_iterator const& b) noexcept
+    {
+      return !(a < b);
+    }
+
+  private:
+    friend class CompactFileIndex;
+    const_iterator(CompactFileIndex const* index, size_type const pos)
+      : index_{index}, pos_{pos}
+    {
+      seek();
+    }
+
+    // Find the blocks of pos_, or the last blocks at the end.
+    void seek() noexcept;
+
+    CompactFileIndex const* index_{nullptr};
+    size_type pos_{};
+    Block const* run_{nullptr};
+    Block const* subRun_{nullptr};
+  };
+
+} // namespace art
+
+#endif /* canvas_Persistency_Provenance_CompactFileIndex_h */
+
+// Local Variables:
+// mode: c++
+// End:
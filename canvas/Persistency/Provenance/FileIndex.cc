@@ -1,14 +1,20 @@
 #include "canvas/Persistency/Provenance/FileIndex.h"
 // vim: set sw=2 expandtab :
 
+#include "canvas/Persistency/Provenance/CompactFileIndex.h"
 #include "canvas/Persistency/Provenance/RunID.h"
 #include "canvas/Persistency/Provenance/SubRunID.h"
 #include "cetlib/container_algorithms.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
+#include "tbb/parallel_invoke.h"
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
 #include <iomanip>
+#include <iterator>
 #include <ostream>
+#include <utility>
 
 using namespace cet;
 using namespace std;
@@ -26,6 +32,118 @@ namespace {
            art::EventID(art::SubRunID::firstSubRun(), eID.event()).isValid();
   }
 
+  // Finalizer of the SplitMix64 generator: a cheap, well-distributed
+  // mixing function for the packed ID numbers.
+  std::uint64_t
+  mix(std::uint64_t x)
+  {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+  }
+
+  std::uint64_t
+  run_event_key(art::EventID const& eID)
+  {
+    return (std::uint64_t{eID.run()} << 32) | eID.event();
+  }
+
+  std::size_t
+  event_hash(art::EventID const& eID)
+  {
+    auto const run_subrun =
+      (std::uint64_t{eID.run()} << 32) | eID.subRun();
+    return mix(run_subrun ^ mix(eID.event()));
+  }
+
+  // Shared by the materialized and compact forms, whose iterators
+  // yield elements by reference and by value, respectively.
+  template <typename Iter>
+  bool
+  events_in_entry_order(Iter it, Iter const end)
+  {
+    art::FileIndex::EntryNumber_t maxEntry{art::FileIndex::Element::invalid};
+    for (; it != end; ++it) {
+      auto const& e = *it;
+      if (e.getEntryType() == art::FileIndex::kEvent) {
+        if (e.entry < maxEntry) {
+          return false;
+        }
+        maxEntry = e.entry;
+      }
+    }
+    return true;
+  }
+
+  template <typename Iter>
+  bool
+  events_unique_and_ordered(Iter it, Iter const end)
+  {
+    // In the trivial case where there is zero or one event, the set
+    // is unique and ordered by construction.
+    art::EventID previous;
+    bool first{true};
+    for (; it != end; ++it) {
+      auto const& e = *it;
+      if (e.getEntryType() != art::FileIndex::kEvent) {
+        continue;
+      }
+      if (!first && e.eventID <= previous) {
+        return false;
+      }
+      previous = e.eventID;
+      first = false;
+    }
+    return true; // finished and found no duplicates
+  }
+
+  // Ranges smaller than this are sorted serially.
+  constexpr std::ptrdiff_t parallel_sort_grain{1 << 16};
+
+  // Stable merge sort of [first, last), recursing on the two halves
+  // in parallel; buffer must have room for last - first elements.
+  template <typename Iter, typename BufferIter, typename Compare>
+  void
+  parallel_stable_sort(Iter const first,
+                       Iter const last,
+                       BufferIter const buffer,
+                       Compare const& comp)
+  {
+    auto const n = last - first;
+    if (n < parallel_sort_grain) {
+      std::stable_sort(first, last, comp);
+      return;
+    }
+    auto const mid = first + n / 2;
+    tbb::parallel_invoke(
+      [&] { parallel_stable_sort(first, mid, buffer, comp); },
+      [&] { parallel_stable_sort(mid, last, buffer + n / 2, comp); });
+    std::move(first, last, buffer);
+    std::merge(std::make_move_iterator(buffer),
+               std::make_move_iterator(buffer + n / 2),
+               std::make_move_iterator(buffer + n / 2),
+               std::make_move_iterator(buffer + n),
+               first,
+               comp);
+  }
+
+  template <typename Compare>
+  void
+  stable_sort_entries(art::FileIndex::iterator const first,
+                      art::FileIndex::iterator const last,
+                      Compare const& comp)
+  {
+    if (last - first < parallel_sort_grain) {
+      std::stable_sort(first, last, comp);
+      return;
+    }
+    std::vector<art::FileIndex::Element> buffer(last - first);
+    parallel_stable_sort(first, last, buffer.begin(), comp);
+  }
+
 } // unnamed namespace
 
 namespace art {
@@ -46,52 +164,96 @@ namespace art {
                                (eventID.subRunID().isValid() ? kSubRun : kRun);
   }
 
+  FileIndex::FileIndex(CompactFileIndex compact)
+  {
+    if (!compact.empty()) {
+      transients_.get().compact =
+        std::make_shared<CompactFileIndex const>(std::move(compact));
+    }
+  }
+
+  CompactFileIndex const*
+  FileIndex::compactEntries() const
+  {
+    return transients_.get().compact.get();
+  }
+
+  void
+  FileIndex::materialize() const
+  {
+    auto& compact = transients_.get().compact;
+    if (!compact) {
+      return;
+    }
+    entries_.reserve(entries_.size() + compact->size());
+    for (auto const& e : *compact) {
+      entries_.push_back(e);
+    }
+    compact.reset();
+  }
+
   FileIndex::iterator
   FileIndex::begin()
   {
+    // The entries may be modified through the returned iterator, so
+    // that the unsorted entries may no longer be only the appended
+    // ones.
+    materialize();
+    transients_.get().prefixSortState = kNotSorted;
+    invalidateEventIndex();
     return entries_.begin();
   }
 
   FileIndex::const_iterator
   FileIndex::begin() const
   {
+    materialize();
     return entries_.begin();
   }
 
   FileIndex::const_iterator
   FileIndex::cbegin() const
   {
+    materialize();
     return entries_.begin();
   }
 
   FileIndex::iterator
   FileIndex::end()
   {
+    materialize();
+    transients_.get().prefixSortState = kNotSorted;
+    invalidateEventIndex();
     return entries_.end();
   }
 
   FileIndex::const_iterator
   FileIndex::end() const
   {
+    materialize();
     return entries_.end();
   }
 
   FileIndex::const_iterator
   FileIndex::cend() const
   {
+    materialize();
     return entries_.end();
   }
 
   std::vector<FileIndex::Element>::size_type
   FileIndex::size() const
   {
+    if (auto const compact = compactEntries()) {
+      return compact->size();
+    }
     return entries_.size();
   }
 
   bool
   FileIndex::empty() const
   {
-    return entries_.empty();
+    return entries_.empty() && compactEntries() == nullptr;
   }
 
   bool&
@@ -115,117 +277,253 @@ namespace art {
   bool
   FileIndex::contains(EventID const& id, bool exact) const
   {
+    // The compact form may answer an inexact lookup with an
+    // unspecified subrun differently; see CompactFileIndex.h.
+    if (auto const compact = compactEntries();
+        compact && (exact || !subRunUnspecified(id))) {
+      return compact->contains(id, exact);
+    }
+    materialize();
     return findPosition(id, exact) != entries_.end();
   }
 
   bool
   FileIndex::contains(SubRunID const& id, bool exact) const
   {
+    if (auto const compact = compactEntries()) {
+      return compact->contains(id, exact);
+    }
     return findPosition(id, exact) != entries_.end();
   }
 
   bool
   FileIndex::contains(RunID const& id, bool exact) const
   {
+    if (auto const compact = compactEntries()) {
+      return compact->contains(id, exact);
+    }
     return findPosition(id, exact) != entries_.end();
   }
 
   void
   FileIndex::addEntry(EventID const& eID, EntryNumber_t const entry)
   {
+    materialize();
     entries_.emplace_back(eID, entry);
     resultCached() = false;
+    auto& t = transients_.get();
+    if (t.sortState != kNotSorted) {
+      t.prefixSortState = t.sortState;
+      t.nAppended = 0;
+    }
+    ++t.nAppended;
     sortState() = kNotSorted;
+    invalidateEventIndex();
   }
 
   void
   FileIndex::addEntryOnLoad(EventID const& eID, EntryNumber_t const entry)
   {
+    materialize();
     entries_.emplace_back(eID, entry);
     resultCached() = false;
+    // Not counted in nAppended, so a later sort must be a full one.
+    transients_.get().prefixSortState = kNotSorted;
+    invalidateEventIndex();
   }
 
   void
   FileIndex::sortBy_Run_SubRun_Event()
   {
-    stable_sort_all(entries_);
-    resultCached() = false;
-    sortState() = kSorted_Run_SubRun_Event;
+    sortEntries(kSorted_Run_SubRun_Event, std::less<Element>{});
   }
 
   void
   FileIndex::sortBy_Run_SubRun_EventEntry()
   {
-    stable_sort_all(entries_, Compare_Run_SubRun_EventEntry());
+    sortEntries(kSorted_Run_SubRun_EventEntry,
+                [](Element const& lh, Element const& rh) {
+                  return Compare_Run_SubRun_EventEntry{}(lh, rh);
+                });
+  }
+
+  template <typename Compare>
+  void
+  FileIndex::sortEntries(SortState const order, Compare comp)
+  {
+    materialize();
+    auto& t = transients_.get();
+    auto const nAppended = t.nAppended;
+    if (t.sortState == kNotSorted && t.prefixSortState == order &&
+        nAppended < entries_.size()) {
+      // Only the appended tail is out of order.
+      auto const mid = entries_.end() - nAppended;
+      stable_sort_entries(mid, entries_.end(), comp);
+      std::inplace_merge(entries_.begin(), mid, entries_.end(), comp);
+    } else {
+      stable_sort_entries(entries_.begin(), entries_.end(), comp);
+    }
+    t.nAppended = 0;
     resultCached() = false;
-    sortState() = kSorted_Run_SubRun_EventEntry;
+    sortState() = order;
+    invalidateEventIndex();
+    if (t.eventIndexEnabled) {
+      buildEventIndex();
+    }
   }
 
-  bool
-  FileIndex::allEventsInEntryOrder() const
+  void
+  FileIndex::enableEventIndex(bool const enable)
   {
-    if (!resultCached()) {
-      resultCached() = true;
-      EntryNumber_t maxEntry{Element::invalid};
-      for (auto const& e : entries_) {
-        if (e.getEntryType() == kEvent) {
-          if (e.entry < maxEntry) {
-            allInEntryOrder() = false;
-            return false;
-          }
-          maxEntry = e.entry;
-        }
-      }
-      allInEntryOrder() = true;
-      return true;
+    auto& t = transients_.get();
+    t.eventIndexEnabled = enable;
+    if (enable) {
+      materialize();
+      buildEventIndex();
+    } else {
+      invalidateEventIndex();
     }
-    return allInEntryOrder();
   }
 
   bool
-  FileIndex::eventsUniqueAndOrdered() const
+  FileIndex::eventIndexEnabled() const
   {
-    auto it = cbegin();
-    auto itEnd = cend();
-    // Set up the iterators to point to first two events
-    // (In the trivial case where there is zero or one event,
-    // the set is unique and ordered by construction).
-    if (it == itEnd) {
-      return true;
+    return transients_.get().eventIndexEnabled;
+  }
+
+  void
+  FileIndex::invalidateEventIndex()
+  {
+    auto& t = transients_.get();
+    if (!t.eventIndexBuilt) {
+      return;
     }
-    // Step to first event
-    while (it->getEntryType() != kEvent) {
-      ++it;
-      if (it == itEnd) {
-        return true;
+    t.eventIndexBuilt = false;
+    std::vector<std::size_t>{}.swap(t.eventSlots);
+    t.runEventPositions.clear();
+  }
+
+  // The index is only ever built by non-const member functions, so
+  // that concurrent lookups do not modify the FileIndex.
+  bool
+  FileIndex::useEventIndex() const
+  {
+    auto const& t = transients_.get();
+    return t.eventIndexEnabled && t.eventIndexBuilt;
+  }
+
+  void
+  FileIndex::buildEventIndex()
+  {
+    auto& t = transients_.get();
+    std::size_t nEvents{};
+    for (auto const& e : entries_) {
+      if (e.getEntryType() == kEvent) {
+        ++nEvents;
       }
     }
-    auto itPrevious = it;
-    // Step to second event
-    ++it;
-    if (it == itEnd) {
-      return true;
+
+    // Keep the load factor at or below one half.
+    std::size_t capacity{16};
+    while (capacity < 2 * nEvents) {
+      capacity *= 2;
     }
-    while (it->getEntryType() != kEvent) {
-      ++it;
-      if (it == itEnd) {
-        return true;
+    std::vector<std::size_t> slots(capacity);
+    std::unordered_multimap<std::uint64_t, std::size_t> runEventPositions;
+    runEventPositions.reserve(nEvents);
+
+    auto const mask = capacity - 1;
+    for (std::size_t i{}, n = entries_.size(); i != n; ++i) {
+      auto const& eID = entries_[i].eventID;
+      if (!eID.isValid()) {
+        continue;
       }
-    }
-    for (; it != itEnd; ++it) {
-      if (it->getEntryType() == kEvent) {
-        if (it->eventID <= itPrevious->eventID) {
-          return false;
+      runEventPositions.emplace(run_event_key(eID), i);
+      // Only the first occurrence of a duplicated ID is recorded,
+      // matching the result of the lower-bound search.
+      for (auto slot = event_hash(eID) & mask;; slot = (slot + 1) & mask) {
+        if (slots[slot] == 0) {
+          slots[slot] = i + 1;
+          break;
+        }
+        if (entries_[slots[slot] - 1].eventID == eID) {
+          break;
         }
-        itPrevious = it;
       }
     }
-    return true; // finished and found no duplicates
+    t.eventSlots = std::move(slots);
+    t.runEventPositions = std::move(runEventPositions);
+    t.eventIndexBuilt = true;
+  }
+
+  FileIndex::const_iterator
+  FileIndex::findEventInIndex(EventID const& eID) const
+  {
+    auto const& slots = transients_.get().eventSlots;
+    auto const mask = slots.size() - 1;
+    for (auto slot = event_hash(eID) & mask; slots[slot] != 0;
+         slot = (slot + 1) & mask) {
+      auto const it = entries_.cbegin() + (slots[slot] - 1);
+      if (it->eventID == eID) {
+        return it;
+      }
+    }
+    return entries_.cend();
+  }
+
+  // Returns true if the answer could be determined from the index
+  // alone: i.e. the requested event number is present in only one
+  // subrun of the run.  Otherwise, the search must fall back to
+  // findEventForUnspecifiedSubRun to preserve its (order-dependent)
+  // choice among the candidate subruns, and the warning it issues
+  // when the event is absent.
+  bool
+  FileIndex::findUniqueEventInIndex(EventID const& eID,
+                                    const_iterator& result) const
+  {
+    auto const [b, e] =
+      transients_.get().runEventPositions.equal_range(run_event_key(eID));
+    if (b == e) {
+      return false;
+    }
+    auto first = b->second;
+    auto const& subRunID = entries_[first].eventID.subRunID();
+    for (auto it = std::next(b); it != e; ++it) {
+      if (entries_[it->second].eventID.subRunID() != subRunID) {
+        return false;
+      }
+      first = std::min(first, it->second);
+    }
+    result = entries_.cbegin() + first;
+    return true;
+  }
+
+  bool
+  FileIndex::allEventsInEntryOrder() const
+  {
+    if (!resultCached()) {
+      resultCached() = true;
+      auto const compact = compactEntries();
+      allInEntryOrder() =
+        compact ? events_in_entry_order(compact->cbegin(), compact->cend()) :
+                  events_in_entry_order(entries_.cbegin(), entries_.cend());
+    }
+    return allInEntryOrder();
+  }
+
+  bool
+  FileIndex::eventsUniqueAndOrdered() const
+  {
+    if (auto const compact = compactEntries()) {
+      return events_unique_and_ordered(compact->cbegin(), compact->cend());
+    }
+    return events_unique_and_ordered(entries_.cbegin(), entries_.cend());
   }
 
   FileIndex::const_iterator
   FileIndex::findPosition(EventID const& eID) const
   {
+    materialize();
     assert(sortState() == kSorted_Run_SubRun_Event);
     Element el{eID};
     return lower_bound_all(entries_, el);
@@ -234,10 +532,18 @@ namespace art {
   FileIndex::const_iterator
   FileIndex::findPosition(EventID const& eID, bool exact) const
   {
+    materialize();
     assert(sortState() == kSorted_Run_SubRun_Event);
     if (subRunUnspecified(eID)) {
+      const_iterator result;
+      if (exact && useEventIndex() && findUniqueEventInIndex(eID, result)) {
+        return result;
+      }
       return findEventForUnspecifiedSubRun(eID, exact);
     }
+    if (exact && useEventIndex()) {
+      return findEventInIndex(eID);
+    }
     const_iterator it = findPosition(eID);
     const_iterator itEnd = entries_.end();
     while (it != itEnd && it->getEntryType() != FileIndex::kEvent) {
@@ -255,6 +561,7 @@ namespace art {
   FileIndex::const_iterator
   FileIndex::findPosition(SubRunID const& srID, bool exact) const
   {
+    materialize();
     assert(sortState() != kNotSorted);
     const_iterator it;
     auto const invID = EventID::invalidEvent(srID);
@@ -280,6 +587,7 @@ namespace art {
   FileIndex::const_iterator
   FileIndex::findPosition(RunID const& rID, bool exact) const
   {
+    materialize();
     assert(sortState() != kNotSorted);
     const_iterator it;
     auto const invID = EventID::invalidEvent(rID);
@@ -305,6 +613,7 @@ namespace art {
   FileIndex::const_iterator
   FileIndex::findSubRunOrRunPosition(SubRunID const& srID) const
   {
+    materialize();
     assert(sortState() != kNotSorted);
     const_iterator it;
     if (sortState() == kSorted_Run_SubRun_EventEntry) {
@@ -328,6 +637,7 @@ namespace art {
           "file.\n\n";
     os << setw(15) << "Run" << setw(15) << "SubRun" << setw(15) << "Event"
        << "\n";
+    materialize();
     for (auto const& e : entries_) {
       if (e.getEntryType() == FileIndex::kEvent) {
         os << setw(15) << e.eventID.run() << setw(15) << e.eventID.subRun()
@@ -450,6 +760,8 @@ namespace art {
   bool
   operator==(FileIndex const& lh, FileIndex const& rh)
   {
+    lh.materialize();
+    rh.materialize();
     return lh.entries_ == rh.entries_;
   }
 
@@ -25,13 +25,27 @@
 //    answer returned by findEventPosition() in these circumstances is
 //    in any way unique.
 //
+// A FileIndex may also be constructed from a CompactFileIndex, e.g. a
+// view of a blob read or mapped from the file, without building its
+// entries: size(), empty(), contains(), allEventsInEntryOrder(), and
+// eventsUniqueAndOrdered() are answered from the compact form.  The
+// first call that needs the entries themselves (iteration,
+// findPosition(), sorting, adding entries, ...) materializes them
+// from it.  That call modifies the index even if it is const, so a
+// FileIndex constructed this way must not be shared among threads
+// before then.
+//
 ////////////////////////////////////////////////////////////////////////
 
 #include "canvas/Persistency/Provenance/EventID.h"
 #include "canvas/Persistency/Provenance/Transient.h"
 #include "canvas/Persistency/Provenance/fwd.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace art {
@@ -79,13 +93,59 @@ namespace art {
       // when we create a new FileIndex, the vector is empty, which is
       // consistent with it having been sorted.
       SortState sortState{kSorted_Run_SubRun_Event};
+
+      // Entries appended with addEntry() since the last sort; the
+      // entries before them remain sorted according to
+      // prefixSortState.  This permits an incremental re-sort.
+      // addEntryOnLoad() and the non-const iterators reset
+      // prefixSortState to kNotSorted, forcing a full sort.
+      SortState prefixSortState{kSorted_Run_SubRun_Event};
+      std::size_t nAppended{};
+
+      // Optional secondary index for constant-time exact event
+      // lookups.  It is built by enableEventIndex() and by each sort
+      // while enabled, and discarded whenever the entries may have
+      // changed; lookups never build it.
+      bool eventIndexEnabled{false};
+      bool eventIndexBuilt{false};
+      // Open-addressed table of (position + 1) into entries_, keyed on
+      // the run, subrun, and event numbers; 0 denotes an empty slot.
+      std::vector<std::size_t> eventSlots{};
+      // Positions of all events, keyed on run and event number only.
+      std::unordered_multimap<std::uint64_t, std::size_t> runEventPositions{};
+
+      // Backing store of an index constructed from a CompactFileIndex
+      // whose entries have not yet been materialized.
+      std::shared_ptr<CompactFileIndex const> compact{};
     };
 
+    FileIndex() = default;
+    // The compact form is sorted by run, subrun, and event number.  If
+    // it is a view, the viewed memory must outlive this index and its
+    // copies, or at least their materialization.  Only materialized
+    // entries are written out; the sort that precedes output
+    // materializes them.
+    explicit FileIndex(CompactFileIndex compact);
+
     void addEntry(EventID const& eID, EntryNumber_t entry);
     void addEntryOnLoad(EventID const& eID, EntryNumber_t entry);
+    // If the index was sorted in the requested order before entries
+    // were appended, only the appended entries are sorted and then
+    // merged in.  Otherwise, large indices are sorted in parallel.
+    // In all cases, the result is that of a stable sort.
     void sortBy_Run_SubRun_Event();
     void sortBy_Run_SubRun_EventEntry();
 
+    // Use a hash index to answer exact event lookups
+    // (findPosition(EventID, true), contains(EventID, true)) in
+    // constant time.  Lookups return the same position as the
+    // default binary search.  The index is built here and after each
+    // sort; once the entries are changed otherwise (addEntryOnLoad(),
+    // the non-const iterators), lookups use the binary search until
+    // the next sort or call to enableEventIndex().
+    void enableEventIndex(bool enable = true);
+    bool eventIndexEnabled() const;
+
     const_iterator findPosition(EventID const& eID) const;
     const_iterator findPosition(EventID const& eID, bool exact) const;
     const_iterator findPosition(SubRunID const& srID, bool exact) const;
@@ -122,8 +182,20 @@ namespace art {
     SortState& sortState() const;
     const_iterator findEventForUnspecifiedSubRun(EventID const& eID,
                                                  bool exact) const;
-
-    std::vector<Element> entries_{};
+    void invalidateEventIndex();
+    void buildEventIndex();
+    bool useEventIndex() const;
+    const_iterator findEventInIndex(EventID const& eID) const;
+    bool findUniqueEventInIndex(EventID const& eID,
+                                const_iterator& result) const;
+    template <typename Compare>
+    void sortEntries(SortState order, Compare comp);
+    CompactFileIndex const* compactEntries() const;
+    void materialize() const;
+
+    // Mutable only so that the entries of an index constructed from a
+    // CompactFileIndex may be materialized on first use.
+    mutable std::vector<Element> entries_{};
     mutable Transient<Transients> transients_{};
   };
 
@@ -3,10 +3,6 @@
 #include "cetlib/MD5Digest.h"
 #include "cetlib/container_algorithms.h"
 
-namespace {
-  std::string const invalid{cet::MD5Result{}.compactForm()};
-}
-
 namespace art::detail {
   void
   fixup(std::string& hash)
@@ -42,6 +38,9 @@ namespace art::detail {
   std::string const&
   InvalidHash()
   {
+    // Function-local so that it is safe to use from the constructors
+    // of other static objects.
+    static std::string const invalid{cet::MD5Result{}.compactForm()};
     return invalid;
   }
 }
@@ -6,16 +6,26 @@
 //
 // Hash:
 //
-// Note: The call to 'fixup' in every member function is a temporary
-// measure for backwards compatibility. It is necessary in every function
-// because Root creates instances of the class *without* using the
-// interface of the class, thus making it insufficient to assure that all
-// constructors make corrected instances.
+// The 16-byte MD5 digest is held in a fixed-size array, so that IDs
+// are trivially copyable, copies never allocate, and comparisons are
+// constexpr comparisons of the bytes.
+//
+// The persistent form is unchanged (class version 10): an std::string
+// data member, hash_, holding the compact 16-byte form of the digest
+// or, in data written by older releases, its hexified 32-character
+// form.  As for ProductID, the dictionary gives Hash a custom streamer
+// (HashStreamer), which writes compactForm() as hash_ and reads hash_
+// back through the string constructor, where the hexified form is
+// converted.
 //
 // ======================================================================
 
 #include "canvas/Utilities/Exception.h"
 
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <functional>
 #include <ostream>
 #include <string>
 
@@ -33,14 +43,12 @@ namespace art {
   template <int I>
   class Hash {
   public:
-    using value_type = std::string;
+    using value_type = std::array<std::byte, 16>;
 
     Hash();
+    // Accepts the compact, hexified, or empty (invalid) forms.
     explicit Hash(std::string const&);
-    Hash(Hash<I> const&);
-    Hash(Hash<I>&&);
-    Hash<I>& operator=(Hash<I> const&);
-    Hash<I>& operator=(Hash<I>&&);
+    constexpr explicit Hash(value_type const& bytes) noexcept;
 
     // For ROOT
     static short Class_Version() noexcept;
@@ -51,18 +59,20 @@ namespace art {
     // string, nor from any string that is not a valid string
     // representation of an MD5 checksum.
     bool isValid() const;
-    bool isCompactForm() const noexcept;
+    // Always true; retained for backwards compatibility.
+    constexpr bool isCompactForm() const noexcept;
     // Return the 16 byte (non-printable) string form.
     std::string compactForm() const;
-    bool operator<(Hash<I> const&) const;
-    bool operator>(Hash<I> const&) const;
-    bool operator==(Hash<I> const&) const;
-    bool operator!=(Hash<I> const&) const;
+    constexpr value_type const& bytes() const noexcept;
+    constexpr bool operator<(Hash<I> const&) const noexcept;
+    constexpr bool operator>(Hash<I> const&) const noexcept;
+    constexpr bool operator==(Hash<I> const&) const noexcept;
+    constexpr bool operator!=(Hash<I> const&) const noexcept;
     std::ostream& print(std::ostream&) const;
-    void swap(Hash<I>&);
+    void swap(Hash<I>&) noexcept;
 
   private:
-    std::string hash_{};
+    value_type hash_{};
   };
 
   // MUST UPDATE WHEN CLASS IS CHANGED!
@@ -76,93 +86,79 @@ namespace art {
   template <int I>
   Hash<I>::Hash()
   {
-    detail::fixup(hash_);
+    std::memcpy(hash_.data(), detail::InvalidHash().data(), hash_.size());
   }
 
   template <int I>
-  Hash<I>::Hash(std::string const& s) : hash_{s}
+  Hash<I>::Hash(std::string const& s)
   {
-    detail::fixup(hash_);
+    if (s.size() == hash_.size()) {
+      std::memcpy(hash_.data(), s.data(), hash_.size());
+      return;
+    }
+    std::string compact{s};
+    detail::fixup(compact);
+    std::memcpy(hash_.data(), compact.data(), hash_.size());
   }
 
   template <int I>
-  Hash<I>::Hash(Hash<I> const& rhs) : hash_{rhs.hash_}
-  {
-    detail::fixup(hash_);
-  }
+  constexpr Hash<I>::Hash(value_type const& bytes) noexcept : hash_{bytes}
+  {}
 
   template <int I>
-  Hash<I>::Hash(Hash<I>&& rhs) : hash_{std::move(rhs.hash_)}
+  bool
+  Hash<I>::isValid() const
   {
-    detail::fixup(hash_);
+    return std::memcmp(
+             hash_.data(), detail::InvalidHash().data(), hash_.size()) != 0;
   }
 
   template <int I>
-  Hash<I>&
-  Hash<I>::operator=(Hash<I> const& rhs)
+  constexpr bool
+  Hash<I>::isCompactForm() const noexcept
   {
-    if (this != &rhs) {
-      hash_ = rhs.hash_;
-      detail::fixup(hash_);
-    }
-    return *this;
+    return true;
   }
 
   template <int I>
-  Hash<I>&
-  Hash<I>::operator=(Hash<I>&& rhs)
+  std::string
+  Hash<I>::compactForm() const
   {
-    hash_ = std::move(rhs.hash_);
-    detail::fixup(hash_);
-    return *this;
+    return std::string(reinterpret_cast<char const*>(hash_.data()),
+                       hash_.size());
   }
 
   template <int I>
-  bool
-  Hash<I>::isValid() const
+  constexpr auto
+  Hash<I>::bytes() const noexcept -> value_type const&
   {
-    if (isCompactForm()) {
-      return hash_ != art::detail::InvalidHash();
-    }
-    return !hash_.empty();
+    return hash_;
   }
 
   template <int I>
-  bool
-  Hash<I>::operator<(Hash<I> const& rhs) const
+  constexpr bool
+  Hash<I>::operator<(Hash<I> const& rhs) const noexcept
   {
-    if (isCompactForm() == rhs.isCompactForm()) {
-      return hash_ < rhs.hash_;
-    }
-    // Force both into compact form.
-    return Hash<I>{*this} < Hash<I>{rhs};
+    return hash_ < rhs.hash_;
   }
 
   template <int I>
-  bool
-  Hash<I>::operator>(Hash<I> const& rhs) const
+  constexpr bool
+  Hash<I>::operator>(Hash<I> const& rhs) const noexcept
   {
-    if (isCompactForm() == rhs.isCompactForm()) {
-      return hash_ > rhs.hash_;
-    }
-    // Force both into compact form.
-    return Hash<I>{*this} > Hash<I>{rhs};
+    return rhs.hash_ < hash_;
   }
 
   template <int I>
-  bool
-  Hash<I>::operator==(Hash<I> const& rhs) const
+  constexpr bool
+  Hash<I>::operator==(Hash<I> const& rhs) const noexcept
   {
-    if (isCompactForm() == rhs.isCompactForm()) {
-      return hash_ == rhs.hash_;
-    }
-    // Force both into compact form.
-    return Hash<I>{*this} == Hash<I>{rhs};
+    return hash_ == rhs.hash_;
   }
 
   template <int I>
-  bool
-  Hash<I>::operator!=(Hash<I> const& rhs) const
+  constexpr bool
+  Hash<I>::operator!=(Hash<I> const& rhs) const noexcept
   {
     return !operator==(rhs);
   }
@@ -171,40 +167,19 @@ namespace art {
   std::ostream&
   Hash<I>::print(std::ostream& os) const
   {
-    Hash<I> tMe{*this};
-    return os << detail::hash_to_string(tMe.hash_);
+    return os << detail::hash_to_string(compactForm());
   }
 
   template <int I>
   void
-  Hash<I>::swap(Hash<I>& rhs)
+  Hash<I>::swap(Hash<I>& rhs) noexcept
   {
-    detail::fixup(hash_);
     hash_.swap(rhs.hash_);
-    detail::fixup(hash_);
-  }
-
-  template <int I>
-  std::string
-  Hash<I>::compactForm() const
-  {
-    if (isCompactForm()) {
-      return hash_;
-    }
-    Hash<I> tMe(*this);
-    return tMe.compactForm();
-  }
-
-  template <int I>
-  bool
-  Hash<I>::isCompactForm() const noexcept
-  {
-    return hash_.size() == 16;
   }
 
   template <int I>
   void
-  swap(Hash<I>& a, Hash<I>& b)
+  swap(Hash<I>& a, Hash<I>& b) noexcept
   {
     a.swap(b);
   }
@@ -218,6 +193,19 @@ namespace art {
 
 } // namespace art
 
+// The digest is already uniformly distributed, so its leading bytes
+// serve directly as the hash value.
+template <int I>
+struct std::hash<art::Hash<I>> {
+  std::size_t
+  operator()(art::Hash<I> const& h) const
+  {
+    std::size_t result;
+    std::memcpy(&result, h.bytes().data(), sizeof(result));
+    return result;
+  }
+};
+
 #endif /* canvas_Persistency_Provenance_Hash_h */
 
 // Local Variables:
@@ -3,11 +3,27 @@
 // vim: set sw=2 expandtab :
 
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
 using namespace std;
 
+namespace {
+
+  art::ParentageID
+  computeID(vector<art::ProductID> const& parents)
+  {
+    ostringstream oss;
+    for (auto const pid : parents) {
+      oss << pid << ' ';
+    }
+    string const stringrep{oss.str()};
+    return art::ParentageID{cet::MD5Digest{stringrep}.digest().compactForm()};
+  }
+
+} // unnamed namespace
+
 namespace art {
 
   Parentage::~Parentage() = default;
@@ -19,18 +35,19 @@ namespace art {
   Parentage& Parentage::operator=(Parentage const&) = default;
   Parentage& Parentage::operator=(Parentage&&) = default;
 
-  Parentage::Parentage(vector<ProductID> parents) : parents_{std::move(parents)}
+  Parentage::Parentage(vector<ProductID> parents)
+    : parents_{std::move(parents)}, id_{computeID(parents_)}
   {}
 
   ParentageID
   Parentage::id() const
   {
-    ostringstream oss;
-    for (auto const pid : parents_) {
-      oss << pid << ' ';
+    // The cached ID is not filled in here, so that concurrent calls on
+    // an object filled by ROOT stay read-only.
+    if (id_.get().isValid()) {
+      return id_;
     }
-    string const stringrep{oss.str()};
-    return ParentageID{cet::MD5Digest{stringrep}.digest().toString()};
+    return computeID(parents_);
   }
 
   vector<ProductID> const&
@@ -6,6 +6,7 @@
 
 #include "canvas/Persistency/Provenance/ParentageID.h"
 #include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Persistency/Provenance/Transient.h"
 
 #include <iosfwd>
 #include <vector>
@@ -25,11 +26,15 @@ namespace art {
     Parentage& operator=(Parentage const&);
     Parentage& operator=(Parentage&&);
 
+    // The ID is computed once, on construction from a list of parents,
+    // and cached.  An object filled by ROOT has no cached ID; its ID is
+    // computed on each call.
     ParentageID id() const;
     std::vector<ProductID> const& parents() const;
 
   private:
     std::vector<ProductID> parents_{};
+    Transient<ParentageID> id_{}; //! transient
   };
 
   std::ostream& operator<<(std::ostream& os, Parentage const&);
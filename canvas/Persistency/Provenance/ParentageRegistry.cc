@@ -0,0 +1,32 @@
+#include "canvas/Persistency/Provenance/ParentageRegistry.h"
+// vim: set sw=2 expandtab :
+
+#include <unordered_set>
+
+using namespace std;
+
+namespace art {
+
+  vector<ParentageID>
+  ParentageRegistry::put_many(span<Parentage const> const parentages)
+  {
+    vector<ParentageID> result;
+    result.reserve(parentages.size());
+
+    // Parentage::id() returns the ID cached on construction; register
+    // each distinct ID once.
+    unordered_set<ParentageID> seen;
+    vector<value_type> entries;
+    for (auto const& p : parentages) {
+      auto const id = p.id();
+      if (seen.insert(id).second) {
+        entries.emplace_back(id, p);
+      }
+      result.push_back(id);
+    }
+
+    put(entries);
+    return result;
+  }
+
+}
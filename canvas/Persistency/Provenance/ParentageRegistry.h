@@ -5,8 +5,19 @@
 #include "canvas/Persistency/Provenance/ParentageID.h"
 #include "canvas/Persistency/Provenance/thread_safe_registry_via_id.h"
 
+#include <span>
+#include <vector>
+
 namespace art {
-  using ParentageRegistry = thread_safe_registry_via_id<ParentageID, Parentage>;
+  class ParentageRegistry
+    : public thread_safe_registry_via_id<ParentageID, Parentage> {
+  public:
+    // Register all of the given parentages, taking the registry lock
+    // only once.  Each distinct ID is registered once.  Returns the IDs
+    // in the order of the input.
+    static std::vector<ParentageID> put_many(
+      std::span<Parentage const> parentages);
+  };
 }
 
 #endif /* canvas_Persistency_Provenance_ParentageRegistry_h */
@@ -0,0 +1,107 @@
+#include "canvas/Persistency/Provenance/ProductLookup.h"
+// vim: set sw=2 expandtab :
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace art;
+
+namespace {
+
+  using Entry = detail::ProductIDIndex::Entry;
+
+  void
+  append(std::vector<ProductID> const& source,
+         std::vector<ProductID>& pids,
+         std::vector<Entry>& entries,
+         Symbol const first,
+         Symbol const second)
+  {
+    auto const begin = static_cast<std::uint32_t>(pids.size());
+    pids.insert(pids.end(), source.begin(), source.end());
+    entries.push_back(
+      {first, second, begin, static_cast<std::uint32_t>(pids.size())});
+  }
+
+} // unnamed namespace
+
+// ======================================================================
+// ProductLookup
+
+// For each friendly class name, the per-process ranges are laid out
+// contiguously in process-name order, followed by an entry (with an
+// invalid process symbol) spanning all of them.
+art::ProductLookup::ProductLookup(ProductLookup_t const& byName)
+{
+  std::vector<Entry> entries;
+  std::vector<ProductID> pids;
+  for (auto const& [fcn, processes] : byName) {
+    Symbol const fcnSymbol{fcn};
+    auto const begin = static_cast<std::uint32_t>(pids.size());
+    for (auto const& [process, processPIDs] : processes) {
+      append(processPIDs, pids, entries, fcnSymbol, Symbol{process});
+    }
+    entries.push_back(
+      {fcnSymbol, Symbol{}, begin, static_cast<std::uint32_t>(pids.size())});
+  }
+  index_ = detail::ProductIDIndex{std::move(entries), std::move(pids)};
+}
+
+std::span<ProductID const>
+art::ProductLookup::find(Symbol const friendlyClassName,
+                         Symbol const processName) const noexcept
+{
+  if (!processName.is_valid()) {
+    return {};
+  }
+  return index_.find(friendlyClassName, processName);
+}
+
+std::span<ProductID const>
+art::ProductLookup::find(std::string_view const friendlyClassName,
+                         std::string_view const processName) const noexcept
+{
+  return find(Symbol::find(friendlyClassName), Symbol::find(processName));
+}
+
+std::span<ProductID const>
+art::ProductLookup::find(Symbol const friendlyClassName) const noexcept
+{
+  return index_.find(friendlyClassName, Symbol{});
+}
+
+std::span<ProductID const>
+art::ProductLookup::find(
+  std::string_view const friendlyClassName) const noexcept
+{
+  return find(Symbol::find(friendlyClassName));
+}
+
+// ======================================================================
+// ViewLookup
+
+art::ViewLookup::ViewLookup(ViewLookup_t const& byName)
+{
+  std::vector<Entry> entries;
+  std::vector<ProductID> pids;
+  for (auto const& [process, processPIDs] : byName) {
+    append(processPIDs, pids, entries, Symbol{process}, Symbol{});
+  }
+  index_ = detail::ProductIDIndex{std::move(entries), std::move(pids)};
+}
+
+std::span<ProductID const>
+art::ViewLookup::find(Symbol const processName) const noexcept
+{
+  if (!processName.is_valid()) {
+    return {};
+  }
+  return index_.find(processName, Symbol{});
+}
+
+std::span<ProductID const>
+art::ViewLookup::find(std::string_view const processName) const noexcept
+{
+  return find(Symbol::find(processName));
+}
@@ -0,0 +1,95 @@
+#ifndef canvas_Persistency_Provenance_ProductLookup_h
+#define canvas_Persistency_Provenance_ProductLookup_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+//
+// ProductLookup and ViewLookup: flat, symbol-keyed forms of the
+// ProductLookup_t and ViewLookup_t lookups.
+//
+// Friendly class names and process names are interned (see
+// canvas/Utilities/Symbol.h), and the product IDs are found with a
+// single hash-table probe keyed on the symbol identifiers, rather than
+// with two string-keyed tree searches.  Looking up by string interns
+// nothing: a name that has never been interned has no products.
+//
+// Product IDs are presented in the same order as in the name-keyed
+// forms from which they are built.  ProductTable holds only the
+// name-keyed forms; a ProductLookup or ViewLookup is built from them
+// by a caller whose lookups use it.
+//
+// ======================================================================
+
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Persistency/Provenance/detail/ProductIDIndex.h"
+#include "canvas/Persistency/Provenance/type_aliases.h"
+#include "canvas/Utilities/Symbol.h"
+
+#include <span>
+#include <string_view>
+
+namespace art {
+
+  class ProductLookup {
+  public:
+    ProductLookup() = default;
+    explicit ProductLookup(ProductLookup_t const& byName);
+
+    // The products of the given friendly class name, created in the
+    // given process.
+    std::span<ProductID const> find(Symbol friendlyClassName,
+                                    Symbol processName) const noexcept;
+    std::span<ProductID const> find(
+      std::string_view friendlyClassName,
+      std::string_view processName) const noexcept;
+
+    // The products of the given friendly class name, created in any
+    // process, ordered by process name.
+    std::span<ProductID const> find(Symbol friendlyClassName) const noexcept;
+    std::span<ProductID const> find(
+      std::string_view friendlyClassName) const noexcept;
+
+    bool
+    empty() const noexcept
+    {
+      return index_.entries().empty();
+    }
+
+  private:
+    detail::ProductIDIndex index_{};
+  };
+
+  class ViewLookup {
+  public:
+    ViewLookup() = default;
+    explicit ViewLookup(ViewLookup_t const& byName);
+
+    // The products supporting views, created in the given process.
+    std::span<ProductID const> find(Symbol processName) const noexcept;
+    std::span<ProductID const> find(
+      std::string_view processName) const noexcept;
+
+    // The products supporting views, ordered by process name.
+    std::span<ProductID const>
+    all() const noexcept
+    {
+      return index_.pids();
+    }
+
+    bool
+    empty() const noexcept
+    {
+      return index_.entries().empty();
+    }
+
+  private:
+    detail::ProductIDIndex index_{};
+  };
+
+} // namespace art
+
+#endif /* canvas_Persistency_Provenance_ProductLookup_h */
+
+// Local Variables:
+// mode: c++
+// End:
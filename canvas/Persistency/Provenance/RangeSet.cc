@@ -11,7 +11,11 @@
 #include "cetlib/crc32.h"
 
 #include <algorithm>
+#include <charconv>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -39,6 +43,51 @@ namespace art {
       return true;
     }
 
+    // Calls f for each element of the ordered merge of the sorted
+    // sequences l and r, without forming the merged sequence.  Stops,
+    // returning false, as soon as f returns false.
+    template <typename F>
+    bool
+    for_each_merged(vector<EventRange> const& l,
+                    vector<EventRange> const& r,
+                    F f)
+    {
+      auto li = l.cbegin(), le = l.cend();
+      auto ri = r.cbegin(), re = r.cend();
+      while (li != le || ri != re) {
+        // Ties are taken from l first, as with std::merge.
+        auto const& cur =
+          (ri == re || (li != le && !(*ri < *li))) ? *li++ : *ri++;
+        if (!f(cur)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // Feed the decimal representation of n (as produced by to_string)
+    // to the CRC without creating a string.
+    void
+    crc_decimal(cet::crc32& crc, unsigned long long const n)
+    {
+      char buf[numeric_limits<unsigned long long>::digits10 + 1];
+      auto const end = to_chars(std::begin(buf), std::end(buf), n).ptr;
+      for (auto p = buf; p != end; ++p) {
+        crc << *p;
+      }
+    }
+
+    // Feed n to the CRC as four little-endian bytes, independent of
+    // the host byte order.
+    void
+    crc_binary(cet::crc32& crc, uint32_t n)
+    {
+      for (int i = 0; i != 4; ++i) {
+        crc << static_cast<char>(n & 0xffu);
+        n >>= 8;
+      }
+    }
+
   } // unnamed namespace
 
   RangeSet
@@ -105,6 +154,19 @@ namespace art {
     if (run_ != r) {
       return false;
     }
+    if (is_indexed()) {
+      // Only the last range beginning at or before (s, e) can contain
+      // the event.
+      auto const it = upper_bound(
+        ranges_.cbegin(),
+        ranges_.cend(),
+        make_pair(s, e),
+        [](auto const& key, EventRange const& range) {
+          return key.first < range.subRun() ||
+                 (key.first == range.subRun() && key.second < range.begin());
+        });
+      return it != ranges_.cbegin() && prev(it)->contains(s, e);
+    }
     for (auto const& range : ranges_) {
       if (range.contains(s, e)) {
         return true;
@@ -163,9 +225,22 @@ namespace art {
     return s;
   }
 
+  bool
+  RangeSet::is_indexed() const
+  {
+    if (index_ == Index::unknown) {
+      index_ =
+        (is_sorted() && disjoint(ranges_)) ? Index::indexed : Index::unindexed;
+    }
+    return index_ == Index::indexed;
+  }
+
   bool
   RangeSet::has_disjoint_ranges() const
   {
+    if (is_indexed()) {
+      return true;
+    }
     if (isCollapsed_ || is_sorted()) {
       return (ranges_.size() < 2ull) ? true : disjoint(ranges_);
     }
@@ -210,10 +285,40 @@ namespace art {
   }
 
   unsigned
-  RangeSet::checksum() const
+  RangeSet::checksum(ChecksumMode const mode) const
   {
-    // Could cache checksums to improve performance when necessary.
-    return checksum_ = cet::crc32{to_compact_string()}.digest();
+    if (mode == ChecksumMode::legacy) {
+      if (legacyChecksum_ != invalidChecksum()) {
+        return legacyChecksum_;
+      }
+      // Equivalent to cet::crc32{to_compact_string()}.digest().
+      cet::crc32 crc;
+      crc_decimal(crc, run_);
+      if (!ranges_.empty()) {
+        crc << ':';
+      }
+      for (auto const& r : ranges_) {
+        crc_decimal(crc, r.subRun());
+        crc << '[';
+        crc_decimal(crc, r.begin());
+        crc << ',';
+        crc_decimal(crc, r.end());
+        crc << ')';
+      }
+      return legacyChecksum_ = crc.digest();
+    }
+
+    if (checksum_ != invalidChecksum()) {
+      return checksum_;
+    }
+    cet::crc32 crc;
+    crc_binary(crc, run_);
+    for (auto const& r : ranges_) {
+      crc_binary(crc, r.subRun());
+      crc_binary(crc, r.begin());
+      crc_binary(crc, r.end());
+    }
+    return checksum_ = crc.digest();
   }
 
   size_t
@@ -233,18 +338,24 @@ namespace art {
   EventRange&
   RangeSet::front()
   {
+    invalidate_checksums();
+    index_ = Index::unknown;
     return ranges_.front();
   }
 
   EventRange&
   RangeSet::back()
   {
+    invalidate_checksums();
+    index_ = Index::unknown;
     return ranges_.back();
   }
 
   EventRange&
   RangeSet::at(size_t idx)
   {
+    invalidate_checksums();
+    index_ = Index::unknown;
     return ranges_.at(idx);
   }
 
@@ -272,7 +383,6 @@ namespace art {
       throw art::Exception(art::errors::LogicError, "RangeSet::collapse()")
         << "A range set must be sorted before it is collapsed.\n";
 
-    auto processing = ranges_;
     decltype(ranges_) result;
     result.reserve(ranges_.size());
     result.push_back(ranges_.front());
@@ -288,6 +398,8 @@ namespace art {
     }
     std::swap(ranges_, result);
     isCollapsed_ = true;
+    index_ = Index::indexed;
+    invalidate_checksums();
     return *this;
   }
 
@@ -300,6 +412,30 @@ namespace art {
     if (!is_valid()) {
       run_ = other.run();
     }
+    if (is_indexed() && other.is_indexed()) {
+      // Merge and collapse in a single pass.
+      vector<EventRange> merged;
+      merged.reserve(ranges_.size() + other.ranges_.size());
+      for_each_merged(ranges_, other.ranges_, [this, &merged](auto const& r) {
+        if (merged.empty()) {
+          merged.push_back(r);
+          return true;
+        }
+        auto& back = merged.back();
+        if (back.is_adjacent(r)) {
+          back.merge(r);
+        } else {
+          throw_if_not_disjoint(run_, back, r);
+          merged.push_back(r);
+        }
+        return true;
+      });
+      std::swap(ranges_, merged);
+      isCollapsed_ = true;
+      index_ = Index::indexed;
+      invalidate_checksums();
+      return *this;
+    }
     vector<EventRange> merged;
     std::merge(ranges_.cbegin(),
                ranges_.cend(),
@@ -309,6 +445,7 @@ namespace art {
     unique(merged.begin(), merged.end());
     std::swap(ranges_, merged);
     isCollapsed_ = false;
+    invalidate_checksums();
     collapse();
     return *this;
   }
@@ -319,6 +456,8 @@ namespace art {
     require_not_full_run();
     if (!rs.ranges_.empty() && (e >= 1) && (e <= rs.ranges_.size())) {
       ranges_.assign(rs.ranges_.cbegin() + b, rs.ranges_.cbegin() + e);
+      invalidate_checksums();
+      index_ = Index::unknown;
     }
   }
 
@@ -329,13 +468,17 @@ namespace art {
     if (ranges_.empty()) {
       run_ = id.run();
       ranges_.emplace_back(id.subRun(), id.event(), id.next().event());
+      range_appended();
       return;
     }
     auto& back = ranges_.back();
     if (back.subRun() == id.subRun() && back.end() == id.event()) {
+      // Extending the last range preserves the indexed state.
       back.set_end(id.next().event());
+      invalidate_checksums();
     } else {
       ranges_.emplace_back(id.subRun(), id.event(), id.next().event());
+      range_appended();
     }
   }
 
@@ -364,6 +507,7 @@ namespace art {
       EventRange right{s, e, end};
       std::swap(*result, right);
       did_split = true;
+      invalidate_checksums();
     }
     return make_pair(static_cast<size_t>(result - ranges_.cbegin()), did_split);
   }
@@ -372,18 +516,25 @@ namespace art {
   RangeSet::set_run(RunNumber_t const r)
   {
     run_ = r;
+    invalidate_checksums();
   }
 
   void
   RangeSet::sort()
   {
     cet::sort_all(ranges_);
+    invalidate_checksums();
+    if (index_ == Index::unindexed) {
+      index_ = Index::unknown;
+    }
   }
 
   void
   RangeSet::clear()
   {
     ranges_.clear();
+    invalidate_checksums();
+    index_ = Index::indexed;
   }
 
   void
@@ -395,6 +546,33 @@ namespace art {
     }
   }
 
+  void
+  RangeSet::invalidate_checksums() noexcept
+  {
+    checksum_ = invalidChecksum();
+    legacyChecksum_ = invalidChecksum();
+  }
+
+  // Maintains the indexed state, in constant time, after a range has
+  // been added to the end of ranges_.
+  void
+  RangeSet::range_appended() noexcept
+  {
+    invalidate_checksums();
+    if (ranges_.size() < 2ull) {
+      index_ = Index::indexed;
+      return;
+    }
+    if (index_ != Index::indexed) {
+      return;
+    }
+    auto const& prev = ranges_[ranges_.size() - 2];
+    auto const& back = ranges_.back();
+    if (back < prev || !prev.is_disjoint(back)) {
+      index_ = Index::unindexed;
+    }
+  }
+
   bool
   operator==(RangeSet const& l, RangeSet const& r)
   {
@@ -434,6 +612,16 @@ namespace art {
     if (l == r)
       return false;
 
+    if (l.is_indexed() && r.is_indexed()) {
+      EventRange const* prev{nullptr};
+      return for_each_merged(
+        l.ranges(), r.ranges(), [&prev](EventRange const& cur) {
+          bool const ok = prev == nullptr || prev->is_disjoint(cur);
+          prev = &cur;
+          return ok;
+        });
+    }
+
     RangeSet ltmp{l};
     RangeSet rtmp{r};
     auto const& lranges = ltmp.collapse().ranges();
@@ -26,6 +26,11 @@ namespace art {
   public:
     using const_iterator = std::vector<EventRange>::const_iterator;
 
+    // The legacy checksum is the CRC-32 of to_compact_string(), as
+    // recorded in files written before the binary checksum was
+    // introduced; it must be used when comparing against such files.
+    enum class ChecksumMode { binary, legacy };
+
     // Static API
     static constexpr unsigned
     invalidChecksum()
@@ -59,6 +64,12 @@ namespace art {
     bool is_full_subRun() const;
     bool is_sorted() const;
     bool is_collapsed() const;
+    // Indexed means that the ranges are sorted and disjoint, in which
+    // case contains() is a binary search, and merge() and
+    // disjoint_ranges() are single linear passes.  Collapsed range
+    // sets are always indexed; the state is otherwise determined on
+    // demand and maintained as ranges are appended.
+    bool is_indexed() const;
 
     std::string to_compact_string() const;
     bool has_disjoint_ranges() const;
@@ -72,7 +83,9 @@ namespace art {
     std::size_t begin_idx() const;
     std::size_t end_idx() const;
 
-    unsigned checksum() const;
+    // Checksums are cached, and recalculated (without allocation) only
+    // after the RangeSet has been modified.
+    unsigned checksum(ChecksumMode mode = ChecksumMode::binary) const;
     std::size_t next_subrun_or_end(std::size_t const b) const;
 
     EventRange& front();
@@ -106,13 +119,18 @@ namespace art {
     explicit RangeSet();
 
     void require_not_full_run();
+    void invalidate_checksums() noexcept;
+    void range_appended() noexcept;
 
     RunNumber_t run_{IDNumber<Level::Run>::invalid()};
     std::vector<EventRange> ranges_{};
 
     // Auxiliary info
+    enum class Index : unsigned char { unknown, indexed, unindexed };
     bool isCollapsed_{false};
+    mutable Index index_{Index::unknown};
     mutable unsigned checksum_{invalidChecksum()};
+    mutable unsigned legacyChecksum_{invalidChecksum()};
   };
 
   template <typename... ARGS>
@@ -122,6 +140,7 @@ namespace art {
     require_not_full_run();
     ranges_.emplace_back(std::forward<ARGS>(args)...);
     isCollapsed_ = false;
+    range_appended();
   }
 
   bool operator==(RangeSet const& l, RangeSet const& r);
@@ -0,0 +1,63 @@
+#include "canvas/Persistency/Provenance/detail/ProductIDIndex.h"
+// vim: set sw=2 expandtab :
+
+#include <bit>
+#include <limits>
+#include <utility>
+
+using namespace art;
+
+namespace {
+  constexpr auto empty_slot = std::numeric_limits<std::uint32_t>::max();
+}
+
+art::detail::ProductIDIndex::ProductIDIndex(std::vector<Entry> entries,
+                                            std::vector<ProductID> pids)
+  : entries_{std::move(entries)}, pids_{std::move(pids)}
+{
+  if (entries_.empty()) {
+    return;
+  }
+  // Keep the load factor at or below one half.
+  auto const n_slots = std::bit_ceil(2 * entries_.size());
+  shift_ = 64 - std::countr_zero(n_slots);
+  slots_.assign(n_slots, empty_slot);
+  auto const mask = n_slots - 1;
+  for (std::uint32_t i{}; i != entries_.size(); ++i) {
+    auto const& entry = entries_[i];
+    auto slot = slot_for(entry.first, entry.second);
+    while (slots_[slot] != empty_slot) {
+      slot = (slot + 1) & mask;
+    }
+    slots_[slot] = i;
+  }
+}
+
+std::size_t
+art::detail::ProductIDIndex::slot_for(Symbol const first,
+                                      Symbol const second) const noexcept
+{
+  // Fibonacci hashing of the combined identifiers; the high bits of
+  // the product are the best mixed.
+  auto const key = (std::uint64_t{first.id()} << 32) | second.id();
+  auto const hash = key * 0x9e3779b97f4a7c15ull;
+  return hash >> shift_;
+}
+
+std::span<ProductID const>
+art::detail::ProductIDIndex::find(Symbol const first,
+                                  Symbol const second) const noexcept
+{
+  if (slots_.empty()) {
+    return {};
+  }
+  auto const mask = slots_.size() - 1;
+  for (auto slot = slot_for(first, second); slots_[slot] != empty_slot;
+       slot = (slot + 1) & mask) {
+    auto const& entry = entries_[slots_[slot]];
+    if (entry.first == first && entry.second == second) {
+      return pids(entry);
+    }
+  }
+  return {};
+}
@@ -0,0 +1,78 @@
+#ifndef canvas_Persistency_Provenance_detail_ProductIDIndex_h
+#define canvas_Persistency_Provenance_detail_ProductIDIndex_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+//
+// ProductIDIndex: An immutable, open-addressed hash table mapping a
+// pair of symbols to a contiguous range of product IDs.
+//
+// All product IDs are held in one vector, and each entry refers to a
+// subrange of it; entries may overlap, so that a range spanning
+// several entries can itself be indexed.  A lookup hashes the two
+// symbol identifiers and probes a flat array of entry indices; no
+// string is examined.
+//
+// ======================================================================
+
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/Symbol.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace art::detail {
+
+  class ProductIDIndex {
+  public:
+    struct Entry {
+      Symbol first;
+      Symbol second;
+      std::uint32_t begin;
+      std::uint32_t end;
+    };
+
+    ProductIDIndex() = default;
+    // No two entries may have the same pair of symbols.
+    ProductIDIndex(std::vector<Entry> entries, std::vector<ProductID> pids);
+
+    // Returns an empty range if there is no such entry.
+    std::span<ProductID const> find(Symbol first,
+                                    Symbol second) const noexcept;
+
+    std::vector<Entry> const&
+    entries() const noexcept
+    {
+      return entries_;
+    }
+
+    std::span<ProductID const>
+    pids() const noexcept
+    {
+      return pids_;
+    }
+
+    std::span<ProductID const>
+    pids(Entry const& entry) const noexcept
+    {
+      return pids().subspan(entry.begin, entry.end - entry.begin);
+    }
+
+  private:
+    std::size_t slot_for(Symbol first, Symbol second) const noexcept;
+
+    std::vector<Entry> entries_{};
+    std::vector<ProductID> pids_{};
+    // Indices into entries_; the size is a power of two.
+    std::vector<std::uint32_t> slots_{};
+    unsigned shift_{};
+  };
+
+} // namespace art::detail
+
+#endif /* canvas_Persistency_Provenance_detail_ProductIDIndex_h */
+
+// Local Variables:
+// mode: c++
+// End:
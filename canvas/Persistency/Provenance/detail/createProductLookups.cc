@@ -3,6 +3,7 @@
 
 #include "canvas/Persistency/Provenance/ProductID.h"
 #include "canvas/Utilities/FriendlyName.h"
+#include "canvas/Utilities/Symbol.h"
 #include "canvas/Utilities/TypeID.h"
 
 #include <algorithm>
@@ -14,9 +15,9 @@ using namespace art;
 namespace {
 
   struct CheapTag {
-    std::string label;
-    std::string instance;
-    std::string process;
+    Symbol label;
+    Symbol instance;
+    Symbol process;
   };
 
   inline bool
@@ -33,7 +34,9 @@ namespace {
                     std::string const& instanceName,
                     std::string const& procName,
                     ProductID const pid)
-      : fcn_{fcn}, ct_{moduleLabel, instanceName, procName}, pid_{pid}
+      : fcn_{fcn}
+      , ct_{Symbol{moduleLabel}, Symbol{instanceName}, Symbol{procName}}
+      , pid_{pid}
     {}
 
     std::string const&
@@ -47,9 +50,9 @@ namespace {
       return ct_;
     }
     std::string const&
-    process() const noexcept
+    process() const
     {
-      return ct_.process;
+      return ct_.process.str();
     }
     ProductID
     pid() const
@@ -95,7 +98,9 @@ art::detail::createProductLookups(ProductDescriptionsByID const& descriptions)
     } else {
       // Add our pid to the list of real Assns<A, B, void>
       // products already registered.
-      insertedABVs.emplace(pid, CheapTag{moduleLabel, instanceName, procName});
+      insertedABVs.emplace(
+        pid,
+        CheapTag{Symbol{moduleLabel}, Symbol{instanceName}, Symbol{procName}});
     }
   }
 
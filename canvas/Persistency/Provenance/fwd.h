@@ -11,6 +11,7 @@ namespace art {
 
   class BranchDescription;
   struct BranchKey;
+  class CompactFileIndex;
   class EventAuxiliary;
   class EventID;
   class EventRange;
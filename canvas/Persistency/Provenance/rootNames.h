@@ -62,7 +62,7 @@ namespace art {
     {
       throw Exception(errors::LogicError)
         << "art::metaBranchRootName requires a specialization for type "
-        << TypeID(typeid(T)).className() << "\n";
+        << TypeID::of<T>().className() << "\n";
     }
 
     ART_ROOTNAME_SIMPLE(FileFormatVersion)
@@ -7,10 +7,19 @@
 // Provides safe access to registry, which never shrinks, but can grow
 // and be read from multiple threads.
 //
-// This DOES NOT prevent reading during a write, nor vice versa.  If
-// one needs to make sure that the contents of the registry are not
-// changing during a read, then a guard must be placed around the
-// registry traversal.
+// Insertions are serialized by a mutex.  Lookups by key, however, do
+// not take the mutex: each inserted element is also published in an
+// append-only, open-addressed hash table of pointers to the elements
+// of the underlying map.  When that table must grow, a new one is
+// filled and published in its place; superseded tables are retained
+// until cleanup so that readers still probing them remain safe.  A
+// lookup that finds its key is therefore wait-free; only a lookup
+// that misses falls back to a search of the map under the mutex.
+//
+// The function returning the entire collection DOES NOT prevent
+// reading during a write, nor vice versa.  If one needs to make sure
+// that the contents of the registry are not changing during a read,
+// then a guard must be placed around the registry traversal.
 //
 // Inefficiencies:
 //
@@ -24,9 +33,14 @@
 
 #include "canvas/Persistency/Provenance/Hash.h"
 
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <type_traits>
+#include <vector>
 
 namespace art {
   template <typename K, typename M>
@@ -48,6 +62,8 @@ namespace art {
       std::lock_guard sentry{mutex_()};
       static collection_type* me = new collection_type{};
       if (cleanup) {
+        index_().store(nullptr, std::memory_order_release);
+        tables_().clear();
         delete me;
         me = nullptr;
         return me;
@@ -60,14 +76,83 @@ namespace art {
     }
 
   private:
+    struct table {
+      explicit table(std::size_t const capacity)
+        : mask{capacity - 1}
+        , slots{std::make_unique<std::atomic<value_type const*>[]>(capacity)}
+      {}
+      std::size_t const mask;
+      std::size_t size{};
+      std::unique_ptr<std::atomic<value_type const*>[]> slots;
+    };
+
     static auto&
     mutex_()
     {
       static std::recursive_mutex m{};
       return m;
     }
+
+    // The table currently receiving insertions.
+    static auto&
+    index_()
+    {
+      static std::atomic<table*> t{nullptr};
+      return t;
+    }
+
+    // All tables ever published, guarded by mutex_().
+    static auto&
+    tables_()
+    {
+      static std::vector<std::unique_ptr<table>> ts{};
+      return ts;
+    }
+
+    template <typename Result>
+    static Result publish_(Result result);
+    static void insert_(table& t, value_type const* p);
   };
 
+  template <typename K, typename M>
+  void
+  thread_safe_registry_via_id<K, M>::insert_(table& t, value_type const* p)
+  {
+    auto slot = std::hash<K>{}(p->first) & t.mask;
+    while (t.slots[slot].load(std::memory_order_relaxed) != nullptr) {
+      slot = (slot + 1) & t.mask;
+    }
+    t.slots[slot].store(p, std::memory_order_release);
+    ++t.size;
+  }
+
+  // Must be called with the mutex held.
+  template <typename K, typename M>
+  template <typename Result>
+  Result
+  thread_safe_registry_via_id<K, M>::publish_(Result const result)
+  {
+    if (!result.second) {
+      return result;
+    }
+    auto t = index_().load(std::memory_order_relaxed);
+    if (t == nullptr || 2 * (t->size + 1) > t->mask + 1) {
+      // Keep the load factor at or below one half.
+      auto fresh = std::make_unique<table>(t == nullptr ? 64 :
+                                                          2 * (t->mask + 1));
+      for (auto const& value : *instance()) {
+        if (&value != &*result.first) {
+          insert_(*fresh, &value);
+        }
+      }
+      t = fresh.get();
+      tables_().push_back(std::move(fresh));
+      index_().store(t, std::memory_order_release);
+    }
+    insert_(*t, &*result.first);
+    return result;
+  }
+
   template <typename K, typename M>
   template <typename C>
   void
@@ -76,7 +161,7 @@ namespace art {
     std::lock_guard sentry{mutex_()};
     auto me = instance();
     for (auto const& e : container) {
-      me->emplace(e);
+      publish_(me->emplace(e));
     }
   }
 
@@ -85,7 +170,7 @@ namespace art {
   thread_safe_registry_via_id<K, M>::emplace(value_type const& value)
   {
     std::lock_guard sentry{mutex_()};
-    return instance()->emplace(value);
+    return publish_(instance()->emplace(value));
   }
 
   template <typename K, typename M>
@@ -93,7 +178,7 @@ namespace art {
   thread_safe_registry_via_id<K, M>::emplace(K const& key, M const& mapped)
   {
     std::lock_guard sentry{mutex_()};
-    return instance()->emplace(key, mapped);
+    return publish_(instance()->emplace(key, mapped));
   }
 
   template <typename K, typename M>
@@ -115,6 +200,16 @@ namespace art {
   bool
   thread_safe_registry_via_id<K, M>::get(K const& k, M& mapped)
   {
+    if (auto const t = index_().load(std::memory_order_acquire)) {
+      auto slot = std::hash<K>{}(k) & t->mask;
+      while (auto const p = t->slots[slot].load(std::memory_order_acquire)) {
+        if (p->first == k) {
+          mapped = p->second;
+          return true;
+        }
+        slot = (slot + 1) & t->mask;
+      }
+    }
     std::lock_guard sentry{mutex_()};
     auto me = instance();
     auto it = me->find(k);
@@ -6,37 +6,166 @@
 #include "canvas/Persistency/Provenance/SubRunID.h"
 #include "canvas/Utilities/Exception.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdio>
+#include <limits>
+#include <map>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace std;
 
 namespace art {
 
-  EventIDMatcher::EventIDMatcher(std::string const& pattern)
-    : pattern_(), parsed_patterns_()
+  namespace {
+
+    // Closed interval, widened so that high + 1 cannot overflow.
+    struct Span {
+      uint64_t low;
+      uint64_t high;
+    };
+
+    // Sort, and merge overlapping or adjacent intervals.
+    void
+    normalize(vector<Span>& spans)
+    {
+      sort(spans.begin(), spans.end(), [](Span const& a, Span const& b) {
+        return a.low < b.low;
+      });
+      vector<Span> result;
+      for (auto const& s : spans) {
+        if (!result.empty() && s.low <= result.back().high + 1) {
+          result.back().high = max(result.back().high, s.high);
+        } else {
+          result.push_back(s);
+        }
+      }
+      spans.swap(result);
+    }
+
+    bool
+    contains(vector<Span> const& spans, uint64_t const value)
+    {
+      return any_of(spans.cbegin(), spans.cend(), [value](Span const& s) {
+        return s.low <= value && value <= s.high;
+      });
+    }
+
+    bool
+    matchable(EventID const& eid)
+    {
+      return eid.isValid() && !eid.isFlush() && eid.subRunID().isValid() &&
+             !eid.subRunID().isFlush() && eid.runID().isValid() &&
+             !eid.runID().isFlush();
+    }
+
+    // Builds the decision structure.  Nodes are memoized on their
+    // level and the set of patterns still active, so that patterns
+    // sharing run and subrun specifications share nodes.
+    class Compiler {
+    public:
+      using Levels = vector<vector<Span>>; // run, subrun, event
+
+      Compiler(vector<Levels> const& patterns) : patterns_{patterns} {}
+
+      template <typename Node, typename Interval>
+      uint32_t
+      build(unsigned const level,
+            vector<unsigned> const& active,
+            vector<Node>& nodes,
+            vector<Interval>& intervals)
+      {
+        auto const key = make_pair(level, active);
+        if (auto it = memo_.find(key); it != memo_.cend()) {
+          return it->second;
+        }
+        vector<Interval> result;
+        if (level == 2u) {
+          vector<Span> events;
+          for (auto const p : active) {
+            auto const& spans = patterns_[p][level];
+            events.insert(events.end(), spans.cbegin(), spans.cend());
+          }
+          normalize(events);
+          for (auto const& s : events) {
+            result.push_back({static_cast<unsigned>(s.low),
+                              static_cast<unsigned>(s.high),
+                              0u});
+          }
+        } else {
+          // Every number between consecutive boundaries matches the
+          // same set of patterns at this level.
+          vector<uint64_t> bounds;
+          for (auto const p : active) {
+            for (auto const& s : patterns_[p][level]) {
+              bounds.push_back(s.low);
+              bounds.push_back(s.high + 1);
+            }
+          }
+          sort(bounds.begin(), bounds.end());
+          bounds.erase(unique(bounds.begin(), bounds.end()), bounds.end());
+          for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+            vector<unsigned> next_active;
+            for (auto const p : active) {
+              if (contains(patterns_[p][level], bounds[i])) {
+                next_active.push_back(p);
+              }
+            }
+            if (next_active.empty()) {
+              continue;
+            }
+            auto const child = build(level + 1, next_active, nodes, intervals);
+            if (nodes[child].begin == nodes[child].end) {
+              // Nothing below can match.
+              continue;
+            }
+            auto const low = static_cast<unsigned>(bounds[i]);
+            auto const high = static_cast<unsigned>(bounds[i + 1] - 1);
+            if (!result.empty() && result.back().next == child &&
+                uint64_t{result.back().high} + 1 == low) {
+              result.back().high = high;
+            } else {
+              result.push_back({low, high, child});
+            }
+          }
+        }
+        auto const begin = static_cast<uint32_t>(intervals.size());
+        intervals.insert(intervals.end(), result.cbegin(), result.cend());
+        nodes.push_back({begin, static_cast<uint32_t>(intervals.size())});
+        auto const index = static_cast<uint32_t>(nodes.size() - 1);
+        memo_.emplace(key, index);
+        return index;
+      }
+
+    private:
+      vector<Levels> const& patterns_;
+      map<pair<unsigned, vector<unsigned>>, uint32_t> memo_;
+    };
+
+  } // unnamed namespace
+
+  EventIDMatcher::EventIDMatcher(std::string const& pattern) : pattern_()
   {
     if (pattern.empty()) {
       throw art::Exception(errors::LogicError)
         << "EventIDMatcher given an empty pattern!";
     }
     pattern_.push_back(pattern);
-    parsed_patterns_.resize(1);
-    parse_pattern();
+    compile(parse_pattern());
   }
 
   EventIDMatcher::EventIDMatcher(std::vector<std::string> const& patterns)
-    : pattern_(), parsed_patterns_()
+    : pattern_()
   {
     if (patterns.size() == 0) {
       throw art::Exception(errors::LogicError)
         << "EventIDMatcher given an empty list of patterns!";
     }
     pattern_.reserve(patterns.size());
-    parsed_patterns_.resize(patterns.size());
     for (auto const& val : patterns) {
       if (val.empty()) {
         throw art::Exception(errors::LogicError)
@@ -44,12 +173,13 @@ namespace art {
       }
       pattern_.push_back(val);
     }
-    parse_pattern();
+    compile(parse_pattern());
   }
 
-  void
-  EventIDMatcher::parse_pattern()
+  EventIDMatcher::parsed_patterns_t
+  EventIDMatcher::parse_pattern() const
   {
+    parsed_patterns_t parsed_patterns(pattern_.size());
     regex pat( // matches ('*' /*wildcard*/ | digits /*single*/ | digits -
                // digits /*range*/)(',' /*list*/ | ':' /*part*/ | eol)
       "("      // 1
@@ -73,7 +203,7 @@ namespace art {
       auto prev_pos = 0L;
       auto prev_len = 0L;
       char prev_sep = '\0';
-      parsed_patterns_[patno].resize(3);
+      parsed_patterns[patno].resize(3);
       // Note: 0: run, 1: subrun, 2: event
       auto part_num = 0U;
       for (; I != E; ++I) {
@@ -97,14 +227,14 @@ namespace art {
         }
         if (m[3].matched) {
           // wildcard
-          parsed_patterns_[patno][part_num].push_back({0U, 0U, true});
+          parsed_patterns[patno][part_num].push_back({0U, 0U, true});
         } else if (m[4].matched) {
           // single num
           auto num = 0U;
           for (auto val : m.str(4)) {
             num = (num * 10U) + (val - '0');
           }
-          parsed_patterns_[patno][part_num].push_back({num, num, false});
+          parsed_patterns[patno][part_num].push_back({num, num, false});
         } else {
           // range
           auto num_low = 0U;
@@ -115,7 +245,7 @@ namespace art {
           for (auto val : m.str(6)) {
             num_high = (num_high * 10U) + (val - '0');
           }
-          parsed_patterns_[patno][part_num].push_back(
+          parsed_patterns[patno][part_num].push_back(
             {num_low, num_high, false});
         }
         if (sep == ':') {
@@ -175,6 +305,61 @@ namespace art {
         throw art::Exception(errors::LogicError) << buf.str();
       }
     }
+    return parsed_patterns;
+  }
+
+  void
+  EventIDMatcher::compile(parsed_patterns_t const& parsed_patterns)
+  {
+    // A pattern matches the events in the product of its run, subrun,
+    // and event sets, so the sets can be normalized independently.
+    vector<Compiler::Levels> patterns;
+    patterns.reserve(parsed_patterns.size());
+    for (auto const& parsed : parsed_patterns) {
+      Compiler::Levels levels(3);
+      for (auto i = 0U; i < 3; ++i) {
+        for (auto const& val : parsed[i]) {
+          if (val.wildcard) {
+            levels[i].push_back({0, numeric_limits<unsigned>::max()});
+          } else if (val.low <= val.high) {
+            levels[i].push_back({val.low, val.high});
+          }
+        }
+        normalize(levels[i]);
+      }
+      patterns.push_back(move(levels));
+    }
+    vector<unsigned> all(patterns.size());
+    for (unsigned i = 0; i != all.size(); ++i) {
+      all[i] = i;
+    }
+    root_ = Compiler{patterns}.build(0, all, nodes_, intervals_);
+  }
+
+  auto
+  EventIDMatcher::find(uint32_t const node, unsigned const value) const
+    -> Interval const*
+  {
+    auto const b = intervals_.data() + nodes_[node].begin;
+    auto const e = intervals_.data() + nodes_[node].end;
+    if (e - b <= 8) {
+      // Covers the wildcard case (a single interval); a short linear
+      // scan beats a binary search.
+      for (auto it = b; it != e; ++it) {
+        if (value <= it->high) {
+          return value >= it->low ? it : nullptr;
+        }
+      }
+      return nullptr;
+    }
+    auto const it =
+      upper_bound(b, e, value, [](unsigned const v, Interval const& i) {
+        return v < i.low;
+      });
+    if (it == b || value > prev(it)->high) {
+      return nullptr;
+    }
+    return prev(it);
   }
 
   bool
@@ -186,84 +371,39 @@ namespace art {
   bool
   EventIDMatcher::match(EventID const& eid) const
   {
-    if (!eid.isValid() || eid.isFlush()) {
+    if (!matchable(eid)) {
       return false;
     }
-    if (!eid.subRunID().isValid() || eid.subRunID().isFlush()) {
-      return false;
-    }
-    if (!eid.runID().isValid() || eid.runID().isFlush()) {
+    auto const run = find(root_, eid.run());
+    if (run == nullptr) {
       return false;
     }
+    auto const subRun = find(run->next, eid.subRun());
+    return subRun != nullptr && find(subRun->next, eid.event()) != nullptr;
+  }
 
-    bool ret = false;
-    for (auto const& parsed_pattern : parsed_patterns_) {
-      for (auto i = 0U; i < 3; ++i) {
-        for (auto const& val : parsed_pattern[i]) {
-          if (val.wildcard) {
-            // Wildcards always match
-            ret = true;
-            break;
-          } else if (val.low == val.high) {
-            // Single value match
-            if (i == 0U) {
-              // run
-              if (eid.run() == val.low) {
-                ret = true;
-                break;
-              }
-            } else if (i == 1U) {
-              // subrun
-              if (eid.subRun() == val.low) {
-                ret = true;
-                break;
-              }
-            } else {
-              // event
-              if (eid.event() == val.low) {
-                ret = true;
-                break;
-              }
-            }
-          } else {
-            // Range match
-            if (i == 0U) {
-              // run
-              if ((eid.run() >= val.low) && (eid.run() <= val.high)) {
-                ret = true;
-                break;
-              }
-            } else if (i == 1U) {
-              // subrun
-              if ((eid.subRun() >= val.low) && (eid.subRun() <= val.high)) {
-                ret = true;
-                break;
-              }
-            } else {
-              // event
-              if ((eid.event() >= val.low) && (eid.event() <= val.high)) {
-                ret = true;
-                break;
-              }
-            }
-          }
-        }
-        if (!ret) {
-          // nothing matched
-          break;
-        }
-        if (i != 2U) {
-          // Reset for next part.
-          ret = false;
-        }
+  void
+  EventIDMatcher::match(span<EventID const> const eids,
+                        vector<bool>& result) const
+  {
+    result.assign(eids.size(), false);
+    SubRunID cachedSubRun{};
+    Interval const* events{nullptr};
+    for (size_t i = 0; i != eids.size(); ++i) {
+      auto const& eid = eids[i];
+      if (!matchable(eid)) {
+        continue;
       }
-      if (ret) {
-        // We matched, return immediately.
-        return ret;
+      if (eid.subRunID() != cachedSubRun) {
+        cachedSubRun = eid.subRunID();
+        events = nullptr;
+        if (auto const run = find(root_, eid.run())) {
+          events = find(run->next, eid.subRun());
+        }
       }
+      result[i] =
+        events != nullptr && find(events->next, eid.event()) != nullptr;
     }
-    // We never matched.
-    return ret;
   }
 
 } // namespace art
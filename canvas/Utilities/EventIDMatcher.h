@@ -4,11 +4,21 @@
 
 #include "canvas/Persistency/Provenance/fwd.h"
 
+#include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace art {
 
+  // The parsed patterns are compiled into a decision structure with
+  // one level each for runs, subruns, and events.  Each node of a
+  // level holds sorted, disjoint, closed intervals of numbers; at the
+  // run and subrun levels each interval refers to the node of the
+  // next level that applies to numbers in that interval, merged
+  // across all patterns.  Matching an event is therefore at most
+  // three searches, independent of the number of patterns.
+
   class EventIDMatcher {
   public:
     explicit EventIDMatcher(std::string const& pattern);
@@ -17,17 +27,37 @@ namespace art {
     bool operator()(EventID const&) const;
     bool match(EventID const&) const;
 
-  private:
-    void parse_pattern();
+    // Sets result[i] to match(eids[i]).  Consecutive events from the
+    // same subrun share the run and subrun searches.
+    void match(std::span<EventID const> eids, std::vector<bool>& result) const;
 
+  private:
     struct PatternRangeElement {
       unsigned low;
       unsigned high;
       bool wildcard;
     };
+    using parsed_patterns_t =
+      std::vector<std::vector<std::vector<PatternRangeElement>>>;
+
+    struct Interval {
+      unsigned low;
+      unsigned high;
+      std::uint32_t next; // Node index; unused for events
+    };
+    struct Node {
+      std::uint32_t begin; // Range of intervals_
+      std::uint32_t end;
+    };
+
+    parsed_patterns_t parse_pattern() const;
+    void compile(parsed_patterns_t const&);
+    Interval const* find(std::uint32_t node, unsigned value) const;
 
     std::vector<std::string> pattern_;
-    std::vector<std::vector<std::vector<PatternRangeElement>>> parsed_patterns_;
+    std::vector<Node> nodes_;
+    std::vector<Interval> intervals_;
+    std::uint32_t root_{};
   };
 
 } // namespace art
@@ -3,140 +3,313 @@
 
 #include "canvas/Utilities/Exception.h"
 
+#include <algorithm>
+#include <initializer_list>
 #include <map>
 #include <mutex>
 #include <regex>
 #include <string>
+#include <string_view>
+#include <utility>
 
-// NOTE: This should probably be rewritten so that we break the class
-// name into a tree where the template arguments are the node.  On the
-// way down the tree we look for '<' or ',' and on the way up (caused by
-// finding a '>') we can apply the transformation to the output string
-// based on the class name for the templated class.  Up front we'd
-// register a class name to a transformation function (which would
-// probably take a std::vector<std::string> which holds the results of
-// the node transformations).
+// The friendly name is produced by a sequence of textual rewrites:
+// standard renames are applied, and then, starting with the innermost,
+// each template instance "C<A,B,...>" is replaced by the concatenation
+// of its arguments and its class name "AB...C" (with art::Assns having
+// its first two arguments sorted).  A rewrite replaces every textual
+// occurrence of the instance, not just the one being visited.
+//
+// Those rules were originally implemented with std::regex, which
+// dominated the time to translate a name.  They are now implemented by
+// direct string scanning, which gives identical results.  The regular
+// expressions constructed from parts of the class name treated any
+// regex metacharacters in it (such as '*' in a pointer type) as
+// syntax; to preserve the names produced for such types, they are
+// still translated by the original implementation (which now reports
+// an error, rather than looping forever, for those it cannot handle).
 
 namespace {
 
-  std::regex const reAllSpaces{" +"};
-  std::regex const reAssns{"art::Assns"};
-  std::regex const reBeginSpace{"^ +"};
-  std::regex const reComma{","};
-  std::regex const reEndSpace{" +$"};
-  std::regex const reParens{"(\\(|\\))"};
-  std::regex const reFirstTwoArgs{"^([^,]+),([^,]+)"};
-  std::regex const reLong{"long "};
-  std::regex const reLongLong{"Long64_t"};
-  std::regex const reMapVector{"cet::map_vector"};
-  std::regex const reMapVectorKey{"cet::map_vector_key"};
-  std::regex const reString{"(?:std::basic_string<char>|std::string)"};
-  std::regex const reTemplateArgs{"([^<]*)<(.*)>$"};
-  std::regex const reTemplateClass{"([^<>,]+<[^<>]*>)"};
-  std::regex const reULongLong{"ULong64_t"};
-  std::regex const reUnsigned{"unsigned "};
-  std::regex const reVector{"std::vector"};
-  std::regex const reWrapper{"art::Wrapper<(.*)>"};
-
   std::string const emptyString{};
 
-  std::string
-  removeExtraSpaces(std::string const& in)
+  // ==================================================================
+  // Translation by string scanning
+
+  void
+  replaceAll(std::string& s,
+             std::initializer_list<std::string_view> const alternatives,
+             std::string_view const replacement)
+  {
+    std::string result;
+    std::size_t done{};
+    for (std::size_t pos{}; pos < s.size();) {
+      auto const it = std::find_if(
+        alternatives.begin(), alternatives.end(), [&s, pos](auto const alt) {
+          return s.compare(pos, alt.size(), alt) == 0;
+        });
+      if (it == alternatives.end()) {
+        ++pos;
+        continue;
+      }
+      result.append(s, done, pos - done).append(replacement);
+      pos += it->size();
+      done = pos;
+    }
+    if (done != 0) {
+      result.append(s, done);
+      s.swap(result);
+    }
+  }
+
+  void
+  replaceAll(std::string& s,
+             std::string_view const target,
+             std::string_view const replacement)
   {
-    return std::regex_replace(std::regex_replace(in, reBeginSpace, emptyString),
-                              reEndSpace,
-                              emptyString);
+    replaceAll(s, {target}, replacement);
   }
 
-  std::string
-  removeAllSpaces(std::string const& in)
+  void
+  eraseAll(std::string& s, char const c)
   {
-    return std::regex_replace(in, reAllSpaces, emptyString);
+    s.erase(std::remove(s.begin(), s.end(), c), s.end());
   }
 
   std::string
-  escapeParens(std::string const& in)
+  removeExtraSpaces(std::string_view const in)
   {
-    return std::regex_replace(in, reParens, "\\$1");
+    auto const b = in.find_first_not_of(' ');
+    if (b == std::string_view::npos) {
+      return emptyString;
+    }
+    return std::string{in.substr(b, in.find_last_not_of(' ') - b + 1)};
   }
 
   std::string
   standardRenames(std::string const& in)
   {
-    std::string name{std::regex_replace(in, reWrapper, "$1")};
-    name = std::regex_replace(name, reString, "String");
-    name = std::regex_replace(name, reUnsigned, "u");
-    name = std::regex_replace(name, reLong, "l");
-    name = std::regex_replace(name, reULongLong, "ull");
-    name = std::regex_replace(name, reLongLong, "ll");
-    name = std::regex_replace(name, reVector, "s");
-    name = std::regex_replace(name, reMapVectorKey, "mvk");
-    name = std::regex_replace(name, reMapVector, "mv");
+    std::string name{in};
+    // art::Wrapper<X> -> X, up to the last '>' in the name.
+    std::string_view const wrapper{"art::Wrapper<"};
+    if (auto const b = name.find(wrapper); b != std::string::npos) {
+      auto const e = name.rfind('>');
+      if (e != std::string::npos && e >= b + wrapper.size()) {
+        name.erase(e, 1);
+        name.erase(b, wrapper.size());
+      }
+    }
+    replaceAll(name, {"std::basic_string<char>", "std::string"}, "String");
+    replaceAll(name, "unsigned ", "u");
+    replaceAll(name, "long ", "l");
+    replaceAll(name, "ULong64_t", "ull");
+    replaceAll(name, "Long64_t", "ll");
+    replaceAll(name, "std::vector", "s");
+    replaceAll(name, "cet::map_vector_key", "mvk");
+    replaceAll(name, "cet::map_vector", "mv");
     return name;
   }
 
-  // Declaration required here because handleTemplateArguments and
-  // subFriendlyName call each other.
-  std::string handleTemplateArguments(std::string const&, std::string const&);
+  std::string handleTemplateArguments(std::string const&, std::string_view);
+
   std::string
-  subFriendlyName(std::string const& iFullName)
+  subFriendlyName(std::string_view const iFullName)
   {
     std::string result{removeExtraSpaces(iFullName)};
-    std::smatch theMatch;
-    if (std::regex_match(result, theMatch, reTemplateArgs)) {
-      std::string const cMatch{theMatch.str(1)};
-      std::string const aMatch{theMatch.str(2)};
-      std::string const theSub{handleTemplateArguments(cMatch, aMatch)};
-      // If a type (e.g.) A was declared in an anonymous namespace,
-      // the demangled typename can be (anonymous namespace)::A.  The
-      // parentheses must be escaped so that they do not interfere
-      // with the regex library.
-      std::regex const eMatch{std::string{"^"} + escapeParens(cMatch) + '<' +
-                              escapeParens(aMatch) + '>'};
-      result = std::regex_replace(result, eMatch, theSub + cMatch);
+    auto const lt = result.find('<');
+    if (lt == std::string::npos || result.back() != '>') {
+      return result;
     }
-    return result;
+    std::string const className{result, 0, lt};
+    auto const args =
+      std::string_view{result}.substr(lt + 1, result.size() - lt - 2);
+    return handleTemplateArguments(className, args) + className;
   }
 
   void
   maybeSwapFirstTwoArgs(std::string& result)
   {
-    std::smatch theMatch;
-    if (std::regex_search(result, theMatch, reFirstTwoArgs) &&
-        (theMatch.str(1) > theMatch.str(2))) {
-      result = std::regex_replace(result, reFirstTwoArgs, "$2,$1");
+    auto const comma = result.find(',');
+    if (comma == 0 || comma == std::string::npos) {
+      return;
+    }
+    auto const end = std::min(result.find(',', comma + 1), result.size());
+    if (end == comma + 1) {
+      return;
+    }
+    std::string_view const all{result};
+    auto const first = all.substr(0, comma);
+    auto const second = all.substr(comma + 1, end - comma - 1);
+    if (first > second) {
+      result = std::string{second}.append(",").append(first).append(
+        all.substr(end));
     }
   }
 
+  // Returns the position and length of the first template instance
+  // whose arguments contain no template instance, including in its
+  // name everything after the preceding '<', '>', or ','.
+  std::pair<std::size_t, std::size_t>
+  firstInnermostTemplate(std::string const& s)
+  {
+    std::size_t begin{};
+    for (std::size_t i{}; i != s.size(); ++i) {
+      auto const c = s[i];
+      if (c == ',' || c == '>') {
+        begin = i + 1;
+      } else if (c == '<') {
+        auto const close = s.find_first_of("<>", i + 1);
+        if (begin != i && close != std::string::npos && s[close] == '>') {
+          return {begin, close - begin + 1};
+        }
+        begin = i + 1;
+      }
+    }
+    return {std::string::npos, 0};
+  }
+
   std::string
-  handleTemplateArguments(std::string const& cName, std::string const& tArgs)
+  handleTemplateArguments(std::string const& cName,
+                          std::string_view const tArgs)
   {
     std::string result{removeExtraSpaces(tArgs)};
-    bool shouldStop{false};
-    while (!shouldStop) {
-      if (std::string::npos != result.find_first_of("<")) {
-        std::smatch theMatch;
-        if (std::regex_search(result, theMatch, reTemplateClass)) {
-          std::string const templateClass{theMatch.str(1)};
-          std::string const friendlierName{
-            removeAllSpaces(subFriendlyName(templateClass))};
-          result = std::regex_replace(
-            result, std::regex(templateClass), friendlierName);
-        } else {
-          throw art::Exception(art::errors::LogicError)
-            << "No template match for \"" << result << '"';
-        }
-      } else {
-        shouldStop = true;
+    while (result.find('<') != std::string::npos) {
+      auto const [pos, len] = firstInnermostTemplate(result);
+      if (pos == std::string::npos) {
+        throw art::Exception(art::errors::LogicError)
+          << "No template match for \"" << result << '"';
       }
+      std::string const templateClass{result, pos, len};
+      std::string friendlierName{subFriendlyName(templateClass)};
+      eraseAll(friendlierName, ' ');
+      replaceAll(result, templateClass, friendlierName);
     }
-    if (std::regex_match(cName, reAssns)) {
+    if (cName == "art::Assns") {
       maybeSwapFirstTwoArgs(result);
     }
-    result = std::regex_replace(result, reComma, emptyString);
+    eraseAll(result, ',');
     return result;
   }
 
+  // ==================================================================
+  // Translation by regular expressions, retained for names containing
+  // regex metacharacters.
+
+  namespace regex_based {
+
+    std::string
+    removeExtraSpaces(std::string const& in)
+    {
+      static std::regex const reBeginSpace{"^ +"};
+      static std::regex const reEndSpace{" +$"};
+      return std::regex_replace(
+        std::regex_replace(in, reBeginSpace, emptyString),
+        reEndSpace,
+        emptyString);
+    }
+
+    std::string
+    removeAllSpaces(std::string const& in)
+    {
+      static std::regex const reAllSpaces{" +"};
+      return std::regex_replace(in, reAllSpaces, emptyString);
+    }
+
+    std::string
+    escapeParens(std::string const& in)
+    {
+      static std::regex const reParens{"(\\(|\\))"};
+      return std::regex_replace(in, reParens, "\\$1");
+    }
+
+    // Declaration required here because handleTemplateArguments and
+    // subFriendlyName call each other.
+    std::string handleTemplateArguments(std::string const&,
+                                        std::string const&);
+    std::string
+    subFriendlyName(std::string const& iFullName)
+    {
+      static std::regex const reTemplateArgs{"([^<]*)<(.*)>$"};
+      std::string result{removeExtraSpaces(iFullName)};
+      std::smatch theMatch;
+      if (std::regex_match(result, theMatch, reTemplateArgs)) {
+        std::string const cMatch{theMatch.str(1)};
+        std::string const aMatch{theMatch.str(2)};
+        std::string const theSub{handleTemplateArguments(cMatch, aMatch)};
+        // If a type (e.g.) A was declared in an anonymous namespace,
+        // the demangled typename can be (anonymous namespace)::A.  The
+        // parentheses must be escaped so that they do not interfere
+        // with the regex library.
+        std::regex const eMatch{std::string{"^"} + escapeParens(cMatch) +
+                                '<' + escapeParens(aMatch) + '>'};
+        result = std::regex_replace(result, eMatch, theSub + cMatch);
+      }
+      return result;
+    }
+
+    void
+    maybeSwapFirstTwoArgs(std::string& result)
+    {
+      static std::regex const reFirstTwoArgs{"^([^,]+),([^,]+)"};
+      std::smatch theMatch;
+      if (std::regex_search(result, theMatch, reFirstTwoArgs) &&
+          (theMatch.str(1) > theMatch.str(2))) {
+        result = std::regex_replace(result, reFirstTwoArgs, "$2,$1");
+      }
+    }
+
+    std::string
+    handleTemplateArguments(std::string const& cName,
+                            std::string const& tArgs)
+    {
+      static std::regex const reTemplateClass{"([^<>,]+<[^<>]*>)"};
+      static std::regex const reAssns{"art::Assns"};
+      static std::regex const reComma{","};
+      std::string result{removeExtraSpaces(tArgs)};
+      bool shouldStop{false};
+      while (!shouldStop) {
+        if (std::string::npos != result.find_first_of("<")) {
+          std::smatch theMatch;
+          if (std::regex_search(result, theMatch, reTemplateClass)) {
+            std::string const templateClass{theMatch.str(1)};
+            std::string const friendlierName{
+              removeAllSpaces(subFriendlyName(templateClass))};
+            auto replaced = std::regex_replace(
+              result, std::regex(templateClass), friendlierName);
+            if (replaced == result) {
+              // The class name, read as a regex, does not match itself
+              // (e.g. "Ptr<T*>"); this would otherwise never terminate.
+              throw art::Exception(art::errors::LogicError)
+                << "Cannot form a friendly name for \"" << templateClass
+                << '"';
+            }
+            result = std::move(replaced);
+          } else {
+            throw art::Exception(art::errors::LogicError)
+              << "No template match for \"" << result << '"';
+          }
+        } else {
+          shouldStop = true;
+        }
+      }
+      if (std::regex_match(cName, reAssns)) {
+        maybeSwapFirstTwoArgs(result);
+      }
+      result = std::regex_replace(result, reComma, emptyString);
+      return result;
+    }
+
+  } // namespace regex_based
+
+  std::string
+  translate(std::string const& iFullName)
+  {
+    auto const name = standardRenames(iFullName);
+    if (name.find_first_of(".[]{}*+?|^$\\") != std::string::npos) {
+      return regex_based::subFriendlyName(name);
+    }
+    return subFriendlyName(name);
+  }
+
 } // unnamed namespace
 
 std::string
@@ -147,9 +320,7 @@ art::friendlyname::friendlyName(std::string const& iFullName)
   std::lock_guard sentry{s_mutex};
   auto entry = s_nameMap.find(iFullName);
   if (entry == s_nameMap.end()) {
-    entry =
-      s_nameMap.emplace(iFullName, subFriendlyName(standardRenames(iFullName)))
-        .first;
+    entry = s_nameMap.emplace(iFullName, translate(iFullName)).first;
   }
   return entry->second;
 }
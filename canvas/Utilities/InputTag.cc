@@ -4,15 +4,73 @@
 #include "boost/algorithm/string/classification.hpp"
 #include "boost/algorithm/string/split.hpp"
 #include "canvas/Utilities/Exception.h"
+#include "canvas/Utilities/Symbol.h"
 #include "fhiclcpp/coding.h"
+#include "tbb/concurrent_unordered_map.h"
 
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 using namespace std;
 
+namespace art::detail {
+  struct InternedInputTag {
+    size_t const hash;
+  };
+}
+
+namespace {
+
+  size_t
+  hash_of(string_view const label,
+          string_view const instance,
+          string_view const process) noexcept
+  {
+    hash<string_view> const h;
+    auto result = h(label);
+    for (auto const s : {instance, process}) {
+      result ^= h(s) + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2);
+    }
+    return result;
+  }
+
+  struct SymbolTriple {
+    art::Symbol label;
+    art::Symbol instance;
+    art::Symbol process;
+    bool operator==(SymbolTriple const&) const = default;
+  };
+
+  struct SymbolTripleHash {
+    size_t
+    operator()(SymbolTriple const& t) const noexcept
+    {
+      size_t result{t.label.id()};
+      for (auto const id : {t.instance.id(), t.process.id()}) {
+        result = result * 0x9e3779b97f4a7c15ull + id;
+      }
+      return result ^ (result >> 29);
+    }
+  };
+
+  // Elements of the pool are never moved or erased, so interned tags
+  // may refer to them for the lifetime of the program.
+  auto&
+  interned_tags()
+  {
+    static tbb::concurrent_unordered_map<SymbolTriple,
+                                         art::detail::InternedInputTag,
+                                         SymbolTripleHash>
+      pool;
+    return pool;
+  }
+
+} // unnamed namespace
+
 namespace art {
 
   InputTag::~InputTag() = default;
@@ -57,14 +115,32 @@ namespace art {
   InputTag::InputTag(char const* s) : InputTag{string{s}} {}
 
   InputTag::InputTag(InputTag const& rhs) = default;
-  InputTag::InputTag(InputTag&& rhs) = default;
+  // A moved-from tag is not interned, since its names are gone.
+  InputTag::InputTag(InputTag&& rhs)
+    : label_{std::move(rhs.label_)}
+    , instance_{std::move(rhs.instance_)}
+    , process_{std::move(rhs.process_)}
+    , interned_{std::exchange(rhs.interned_, nullptr)}
+  {}
 
   InputTag& InputTag::operator=(InputTag const& rhs) = default;
-  InputTag& InputTag::operator=(InputTag&& rhs) = default;
+
+  InputTag&
+  InputTag::operator=(InputTag&& rhs)
+  {
+    label_ = std::move(rhs.label_);
+    instance_ = std::move(rhs.instance_);
+    process_ = std::move(rhs.process_);
+    interned_ = std::exchange(rhs.interned_, nullptr);
+    return *this;
+  }
 
   bool
   InputTag::operator==(InputTag const& tag) const noexcept
   {
+    if (interned_ != nullptr && tag.interned_ != nullptr) {
+      return interned_ == tag.interned_;
+    }
     return (label_ == tag.label_) && (instance_ == tag.instance_) &&
            (process_ == tag.process_);
   }
@@ -107,6 +183,41 @@ namespace art {
     return result;
   }
 
+  InputTag
+  InputTag::interned() const
+  {
+    if (interned_ != nullptr) {
+      return *this;
+    }
+    SymbolTriple const key{
+      Symbol{label_}, Symbol{instance_}, Symbol{process_}};
+    auto& pool = interned_tags();
+    auto it = pool.find(key);
+    if (it == pool.end()) {
+      // If another thread inserts the same tag first, its record is
+      // used.
+      it = pool.emplace(key, detail::InternedInputTag{hash()}).first;
+    }
+    InputTag result{*this};
+    result.interned_ = &it->second;
+    return result;
+  }
+
+  bool
+  InputTag::is_interned() const noexcept
+  {
+    return interned_ != nullptr;
+  }
+
+  size_t
+  InputTag::hash() const noexcept
+  {
+    if (interned_ != nullptr) {
+      return interned_->hash;
+    }
+    return hash_of(label_, instance_, process_);
+  }
+
   bool
   operator!=(InputTag const& left, InputTag const& right)
   {
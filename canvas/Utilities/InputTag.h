@@ -2,13 +2,41 @@
 #define canvas_Utilities_InputTag_h
 // vim: set sw=2 expandtab :
 
+// ======================================================================
+//
+// InputTag: The module label, instance name, and process name of a
+// product.
+//
+// An InputTag may be interned (see interned()), in which case it also
+// refers to a record, in a process-wide pool, holding its precomputed
+// hash.  Two interned tags compare equal if and only if they refer to
+// the same record.  Interned and non-interned tags may be freely
+// compared and mixed in containers; a tag's names, hash, and encoded
+// form do not depend on whether it is interned.
+//
+// Interning is not a handle representation: an interned tag still
+// holds its own copies of the three names, which are its persistent
+// data, so copying it copies the strings.  What interning saves is the
+// hashing and comparison of the names.
+//
+// The pool reference is transient: a tag read from persistent storage
+// is not interned, nor is a tag whose names have been moved from.
+//
+// ======================================================================
+
 #include <any>
+#include <cstddef>
+#include <functional>
 #include <iosfwd>
 #include <string>
 #include <tuple>
 
 namespace art {
 
+  namespace detail {
+    struct InternedInputTag;
+  }
+
   class InputTag {
   public:
     ~InputTag();
@@ -42,10 +70,18 @@ namespace art {
 
     std::string encode() const;
 
+    // Returns an interned copy of this tag.
+    InputTag interned() const;
+    bool is_interned() const noexcept;
+
+    // Computed once per interned tag, on every call otherwise.
+    std::size_t hash() const noexcept;
+
   private:
     std::string label_{};
     std::string instance_{};
     std::string process_{};
+    detail::InternedInputTag const* interned_{nullptr}; //! transient
   };
 
   bool operator!=(InputTag const&, InputTag const&);
@@ -73,6 +109,15 @@ namespace std {
   };
 }
 
+template <>
+struct std::hash<art::InputTag> {
+  std::size_t
+  operator()(art::InputTag const& tag) const noexcept
+  {
+    return tag.hash();
+  }
+};
+
 #endif /* canvas_Utilities_InputTag_h */
 
 // Local Variables:
@@ -0,0 +1,88 @@
+#include "canvas/Utilities/Symbol.h"
+// vim: set sw=2 expandtab :
+
+#include "canvas/Utilities/Exception.h"
+#include "tbb/concurrent_unordered_map.h"
+#include "tbb/concurrent_vector.h"
+
+#include <mutex>
+#include <ostream>
+
+using namespace std;
+
+namespace {
+
+  // The strings are owned by a concurrent_vector, whose elements are
+  // never moved; the map keys refer to them.  A string is appended to
+  // the vector before its identifier is published in the map, so any
+  // identifier obtained from the map may be used to index the vector.
+  struct SymbolTable {
+    tbb::concurrent_vector<string> strings;
+    tbb::concurrent_unordered_map<string_view, art::Symbol::id_type> ids;
+    mutex insertion_mutex;
+  };
+
+  SymbolTable&
+  symbol_table()
+  {
+    static SymbolTable table;
+    return table;
+  }
+
+} // unnamed namespace
+
+namespace art {
+
+  Symbol::Symbol(string_view const s)
+  {
+    auto& table = symbol_table();
+    if (auto it = table.ids.find(s); it != table.ids.end()) {
+      id_ = it->second;
+      return;
+    }
+    lock_guard sentry{table.insertion_mutex};
+    if (auto it = table.ids.find(s); it != table.ids.end()) {
+      id_ = it->second;
+      return;
+    }
+    auto const id = table.strings.size();
+    if (id >= invalid_id) {
+      throw Exception(errors::LogicError)
+        << "The maximum number of distinct symbols (" << invalid_id
+        << ") has been exceeded.\n";
+    }
+    auto const pos = table.strings.emplace_back(s);
+    table.ids.emplace(string_view{*pos}, static_cast<id_type>(id));
+    id_ = static_cast<id_type>(id);
+  }
+
+  Symbol
+  Symbol::find(string_view const s) noexcept
+  {
+    auto const& table = symbol_table();
+    if (auto it = table.ids.find(s); it != table.ids.end()) {
+      return Symbol{it->second};
+    }
+    return Symbol{};
+  }
+
+  string const&
+  Symbol::str() const
+  {
+    if (!is_valid()) {
+      throw Exception(errors::LogicError)
+        << "Attempt to retrieve the string of an invalid Symbol.\n";
+    }
+    return symbol_table().strings[id_];
+  }
+
+  ostream&
+  operator<<(ostream& os, Symbol const s)
+  {
+    if (!s.is_valid()) {
+      return os << "<invalid symbol>";
+    }
+    return os << s.str();
+  }
+
+} // namespace art
@@ -0,0 +1,103 @@
+#ifndef canvas_Utilities_Symbol_h
+#define canvas_Utilities_Symbol_h
+// vim: set sw=2 expandtab :
+
+//
+// Symbol: An interned string.
+//
+// Each distinct string interned during the program's lifetime is
+// assigned a small integer identifier, so that symbols may be
+// compared and hashed without examining the characters.  The interned
+// strings are never released, and references to them remain valid
+// for the lifetime of the program.
+//
+// Interning a string that has already been interned, and looking up a
+// string with Symbol::find, do not take a lock.  Identifiers are
+// assigned in the order in which strings are first interned; they
+// cannot be persisted across invocations of the program.
+//
+// A default-constructed Symbol is invalid: it corresponds to no
+// string (not even the empty one).
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace art {
+
+  class Symbol {
+  public:
+    using id_type = std::uint32_t;
+    static constexpr id_type invalid_id{
+      std::numeric_limits<id_type>::max()};
+
+    constexpr Symbol() noexcept = default;
+    // Interns the string if it has not been interned before.
+    explicit Symbol(std::string_view);
+
+    // Returns an invalid Symbol if the string has never been interned.
+    static Symbol find(std::string_view) noexcept;
+
+    constexpr bool
+    is_valid() const noexcept
+    {
+      return id_ != invalid_id;
+    }
+
+    constexpr id_type
+    id() const noexcept
+    {
+      return id_;
+    }
+
+    // Must not be called for an invalid Symbol.
+    std::string const& str() const;
+
+    constexpr bool
+    operator==(Symbol const other) const noexcept
+    {
+      return id_ == other.id_;
+    }
+
+    constexpr bool
+    operator!=(Symbol const other) const noexcept
+    {
+      return id_ != other.id_;
+    }
+
+    // Orders by identifier, not alphabetically.
+    constexpr bool
+    operator<(Symbol const other) const noexcept
+    {
+      return id_ < other.id_;
+    }
+
+  private:
+    constexpr explicit Symbol(id_type const id) noexcept : id_{id} {}
+
+    id_type id_{invalid_id};
+  };
+
+  std::ostream& operator<<(std::ostream&, Symbol);
+
+} // namespace art
+
+template <>
+struct std::hash<art::Symbol> {
+  std::size_t
+  operator()(art::Symbol const s) const noexcept
+  {
+    return s.id();
+  }
+};
+
+#endif /* canvas_Utilities_Symbol_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -4,10 +4,9 @@
 #include "canvas/Utilities/Exception.h"
 #include "canvas/Utilities/FriendlyName.h"
 #include "canvas/Utilities/uniform_type_name.h"
+#include "tbb/concurrent_unordered_map.h"
 
 #include <cstddef>
-#include <map>
-#include <mutex>
 #include <ostream>
 #include <string>
 #include <typeinfo>
@@ -16,8 +15,9 @@
 using namespace std;
 
 namespace {
-  map<size_t, string> name_cache{};
-  mutex cache_mutex{};
+  // Lookups and insertions may proceed concurrently, and inserted
+  // elements are never moved, so references to the names remain valid.
+  tbb::concurrent_unordered_map<size_t, string> name_cache{};
 }
 
 namespace art {
@@ -44,13 +44,17 @@ namespace art {
     return ti_->name();
   }
 
-  string
+  string const&
   TypeID::className() const
   {
-    auto hash_code = typeInfo().hash_code();
-    std::lock_guard sentry{cache_mutex};
+    if (className_ != nullptr) {
+      return className_();
+    }
+    auto const hash_code = typeInfo().hash_code();
     auto entry = name_cache.find(hash_code);
     if (entry == name_cache.end()) {
+      // If another thread inserts the same name first, its entry is
+      // used.
       entry =
         name_cache.emplace(hash_code, uniform_type_name(typeInfo())).first;
     }
@@ -84,6 +88,7 @@ namespace art {
   TypeID::swap(TypeID& other)
   {
     std::swap(ti_, other.ti_);
+    std::swap(className_, other.className_);
   }
 
   void
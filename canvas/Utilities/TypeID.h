@@ -10,6 +10,12 @@
 // that a type_info should have a unique address for performance
 // reasons) but cannot be persisted across invocations of the program.
 //
+// Class names are computed once per type and cached for the lifetime
+// of the program; className() returns a reference to the cached name.
+// Looking up a cached name does not take a lock.  A TypeID created by
+// TypeID::of<T>() additionally remembers the name in a static local
+// of a function instantiated for T, avoiding even the lookup.
+//
 
 #include <iosfwd>
 #include <string>
@@ -26,6 +32,9 @@ namespace art {
 
     template <typename T>
     explicit TypeID(T const& val) noexcept;
+    template <typename T>
+    static TypeID of() noexcept;
+
     TypeID(TypeID const&) noexcept;
     TypeID(TypeID&) noexcept;
     TypeID& operator=(TypeID const&) noexcept;
@@ -33,7 +42,7 @@ namespace art {
 
     std::type_info const& typeInfo() const;
     char const* name() const;
-    std::string className() const;
+    std::string const& className() const;
     std::string friendlyClassName() const;
     bool operator<(TypeID const&) const;
     bool operator==(TypeID const&) const;
@@ -42,13 +51,35 @@ namespace art {
     void print(std::ostream&) const;
 
   private:
+    using class_name_fn = std::string const& (*)();
+
     std::type_info const* ti_{nullptr};
+    class_name_fn className_{nullptr}; // Set only by of<T>()
   };
 
+  namespace detail {
+    template <typename T>
+    std::string const&
+    class_name_of()
+    {
+      static std::string const& name{TypeID{typeid(T)}.className()};
+      return name;
+    }
+  }
+
   template <typename T>
   TypeID::TypeID(T const& val) noexcept : ti_{&typeid(val)}
   {}
 
+  template <typename T>
+  TypeID
+  TypeID::of() noexcept
+  {
+    TypeID result{typeid(T)};
+    result.className_ = &detail::class_name_of<T>;
+    return result;
+  }
+
   inline bool
   is_instantiation_of(std::string const& type_name,
                       std::string const& template_name)
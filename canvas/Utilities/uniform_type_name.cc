@@ -2,30 +2,145 @@
 
 #include "cetlib/replace_all.h"
 
-#include <regex>
+#include <cctype>
 #include <string>
+#include <string_view>
+
+// The transformations below were originally expressed as regular
+// expressions, each applied repeatedly until the name no longer
+// changed.  They are now single scans over the name; each gives the
+// same result as the regular expression did at its fixed point.
 
 namespace {
-  /// \fn reformat.
+  bool
+  is_digit(char const c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  /// \fn stripInlineNamespaces.
   ///
-  /// \brief Reformat the input string according to the provided regex
-  /// and format string.
+  /// \brief Replace each "std::__<digits>::" or "std::__cxx11::" with
+  /// "std::", including those nested ("std::__1::__cxx11::").
   ///
-  /// \param[in,out] input The string to be manipulated.
+  /// \param[in,out] name The string to manipulate.
+  void
+  stripInlineNamespaces(std::string& name)
+  {
+    std::string_view const std_ns{"std::"};
+    auto const inline_ns_size = [&name](std::size_t const pos) {
+      // Size of the "__<digits>::" or "__cxx11::" at pos, or zero.
+      if (name.compare(pos, 2, "__") != 0) {
+        return std::size_t{};
+      }
+      auto end = pos + 2;
+      if (name.compare(end, 5, "cxx11") == 0) {
+        end += 5;
+      } else {
+        while (end < name.size() && is_digit(name[end])) {
+          ++end;
+        }
+        if (end == pos + 2) {
+          return std::size_t{};
+        }
+      }
+      return name.compare(end, 2, "::") == 0 ? end + 2 - pos : std::size_t{};
+    };
+    std::string result;
+    std::size_t done{};
+    for (auto pos = name.find(std_ns); pos != std::string::npos;
+         pos = name.find(std_ns, pos)) {
+      pos += std_ns.size();
+      auto skip = pos;
+      while (auto const n = inline_ns_size(skip)) {
+        skip += n;
+      }
+      if (skip != pos) {
+        result.append(name, done, pos - done);
+        done = pos = skip;
+      }
+    }
+    if (done != 0) {
+      result.append(name, done);
+      name.swap(result);
+    }
+  }
+
+  /// \fn canonicalizeBasicString.
   ///
-  /// \param[in] exp The regular expression to be (repeatedly) applied.
+  /// \brief Replace "std::basic_string<char>", and any whitespace
+  /// following it, with "std::string".
   ///
-  /// \param[format] format The specified format string for the
-  /// replacement.
+  /// \param[in,out] name The string to manipulate.
   void
-  reformat(std::string& input, std::regex const& exp, std::string const& format)
+  canonicalizeBasicString(std::string& name)
   {
-    while (1) {
-      std::string const formatted = std::regex_replace(input, exp, format);
-      if (formatted == input) {
-        break;
-      } else {
-        input = formatted;
+    std::string_view const basic_string{"std::basic_string<char>"};
+    for (auto pos = name.find(basic_string); pos != std::string::npos;
+         pos = name.find(basic_string, pos)) {
+      auto end = pos + basic_string.size();
+      while (end < name.size() &&
+             std::isspace(static_cast<unsigned char>(name[end]))) {
+        ++end;
+      }
+      name.replace(pos, end - pos, "std::string");
+      pos += 11;
+    }
+  }
+
+  /// \fn removeSpacesBeforeClosingBrackets.
+  ///
+  /// \brief Remove spaces between an identifier or number and a
+  /// following '>'.
+  ///
+  /// \param[in,out] name The string to manipulate.
+  void
+  removeSpacesBeforeClosingBrackets(std::string& name)
+  {
+    auto const is_word = [](char const c) {
+      return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+             (c >= '0' && c <= '9');
+    };
+    std::size_t out{};
+    for (std::size_t in{}; in < name.size();) {
+      if (name[in] == ' ' && out != 0 && is_word(name[out - 1])) {
+        auto const end = name.find_first_not_of(' ', in);
+        if (end != std::string::npos && name[end] == '>') {
+          in = end;
+          continue;
+        }
+      }
+      name[out++] = name[in++];
+    }
+    name.resize(out);
+  }
+
+  /// \fn removeIntegerSuffixes.
+  ///
+  /// \brief Remove the 'u' and 'l' suffixes from integer template
+  /// arguments (e.g. "<3ul>" -> "<3>").
+  ///
+  /// \param[in,out] name The string to manipulate.
+  void
+  removeIntegerSuffixes(std::string& name)
+  {
+    for (auto pos = name.find_first_of("<,"); pos != std::string::npos;
+         pos = name.find_first_of("<,", pos + 1)) {
+      auto digits_end = pos + 1;
+      while (digits_end < name.size() && is_digit(name[digits_end])) {
+        ++digits_end;
+      }
+      if (digits_end == pos + 1 || digits_end == name.size() ||
+          (name[digits_end] != 'u' && name[digits_end] != 'l')) {
+        continue;
+      }
+      auto suffix_end = digits_end + 1;
+      while (suffix_end < name.size() && name[suffix_end] == 'l') {
+        ++suffix_end;
+      }
+      if (suffix_end < name.size() &&
+          (name[suffix_end] == ',' || name[suffix_end] == '>')) {
+        name.erase(digits_end, suffix_end - digits_end);
       }
     }
   }
@@ -136,11 +251,7 @@ namespace {
   translateInlineNamespace(std::string& name)
   {
     // libc++/libstdc++ std::ABI_TAG -> std::
-    {
-      static std::regex const ns_regex("std::__([[:digit:]]+|cxx11)::");
-      static std::string const ns_format("std::");
-      reformat(name, ns_regex, ns_format);
-    }
+    stripInlineNamespaces(name);
 
     // Apply Itanium abbreviations
     // FIXME: If the need arises, may need to apply other abbreviations:
@@ -184,21 +295,14 @@ art::uniform_type_name(std::string name)
   // Strip char traits.
   removeParameter(name, ",std::char_traits<"s);
   // std::basic_string<char> -> std::string
-  {
-    static std::regex const bs_regex("std::basic_string<char>\\s*"s);
-    reformat(name, bs_regex, "std::string"s);
-  }
+  canonicalizeBasicString(name);
   // Put const qualifier before identifier.
   constBeforeIdentifier(name);
 
-  // No spaces between template brakets and arguments
-  // FIXME?: need a regex because just stripping the spaces
-  // can cause subsequent ">>" removal fail...
-  {
-    static std::regex const bk_regex("([_a-zA-Z0-9])( +)>");
-    static std::string const bk_format("$1>");
-    reformat(name, bk_regex, bk_format);
-  }
+  // No spaces between template brakets and arguments.  Only spaces
+  // following an identifier or number are removed, because just
+  // stripping the spaces can cause subsequent ">>" removal to fail...
+  removeSpacesBeforeClosingBrackets(name);
 
   // No consecutive '>'.
   //
@@ -206,10 +310,7 @@ art::uniform_type_name(std::string name)
   // template argument, we could have a problem.
   cet::replace_all(name, ">>"s, "> >"s);
   // No u or l qualifiers for integers.
-  {
-    static std::regex const ul_regex("(.*[<,][0-9]+)[ul]l*([,>].*)"s);
-    reformat(name, ul_regex, "$1$2"s);
-  }
+  removeIntegerSuffixes(name);
   // For ROOT 6 and beyond.
   cet::replace_all(name, "unsigned long long"s, "ULong64_t"s);
   cet::replace_all(name, "long long"s, "Long64_t"s);
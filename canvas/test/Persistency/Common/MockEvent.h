@@ -0,0 +1,124 @@
+#ifndef canvas_test_Persistency_Common_MockEvent_h
+#define canvas_test_Persistency_Common_MockEvent_h
+
+// Stand-ins for the framework pieces through which products are found:
+//
+//   - MockEvent: just enough of an event for IPRHelper, which yields
+//     the one product it was made with (if any), whatever the tag;
+//
+//   - MockGetter: an EDProductGetter owning its product, which counts
+//     the calls to getIt() and may report the product as ready;
+//
+//   - NoProductGetter: an EDProductGetter whose product is never found,
+//     which counts the calls to getIt().
+
+#include "canvas/Persistency/Common/EDProductGetter.h"
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Utilities/Exception.h"
+#include "canvas/Utilities/InputTag.h"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace arttest {
+
+  template <typename A>
+  class MockEvent {
+  public:
+    template <typename T>
+    class HandleT {
+    public:
+      bool
+      isValid() const
+      {
+        return product_ != nullptr;
+      }
+      std::shared_ptr<art::Exception const>
+      whyFailed() const
+      {
+        return std::make_shared<art::Exception const>(
+          art::errors::ProductNotFound);
+      }
+      T const&
+      operator*() const
+      {
+        return *product_;
+      }
+      T const* product_{nullptr};
+    };
+
+    explicit MockEvent(A const& product) : product_{&product} {}
+    // No product is found.
+    explicit MockEvent(std::nullptr_t) {}
+
+    void
+    getByLabel(art::InputTag const&, HandleT<A>& handle) const
+    {
+      handle.product_ = product_;
+    }
+
+  private:
+    A const* product_{nullptr};
+  };
+
+  template <typename P>
+  class MockGetter : public art::EDProductGetter {
+  public:
+    explicit MockGetter(P product, bool const ready = false)
+      : wrapper_{std::make_unique<P>(std::move(product))}, ready_{ready}
+    {}
+
+    unsigned
+    calls() const
+    {
+      return calls_;
+    }
+
+  private:
+    art::EDProduct const*
+    getIt_() const override
+    {
+      ++calls_;
+      return &wrapper_;
+    }
+
+    art::EDProduct const*
+    getItIfReady_() const override
+    {
+      return ready_ ? &wrapper_ : nullptr;
+    }
+
+    art::Wrapper<P> wrapper_;
+    bool ready_;
+    mutable unsigned calls_{};
+  };
+
+  using FloatsGetter = MockGetter<std::vector<float>>;
+
+  class NoProductGetter : public art::EDProductGetter {
+  public:
+    unsigned
+    calls() const
+    {
+      return calls_;
+    }
+
+  private:
+    art::EDProduct const*
+    getIt_() const override
+    {
+      ++calls_;
+      return nullptr;
+    }
+
+    mutable unsigned calls_{};
+  };
+}
+
+#endif /* canvas_test_Persistency_Common_MockEvent_h */
+
+// Local variables:
+// mode: c++
+// End:
@@ -0,0 +1,228 @@
+#define BOOST_TEST_MODULE (assns_encoding_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/AssnsBase.h"
+#include "canvas/Persistency/Common/EDProductGetter.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/RefCore.h"
+#include "canvas/Persistency/Common/detail/AssnsEncoding.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using namespace art;
+using art::detail::AssnsColumnDecoder;
+using art::detail::AssnsColumnEncoder;
+
+// Stands in for the streamer of the framework, which is granted access
+// to the persistent members of Assns.
+class art::detail::AssnsStreamer {
+public:
+  // The numbers of items written in the version 11 form, and of bytes
+  // written in the compact form, for the first column.
+  template <typename L, typename R>
+  static std::pair<std::size_t, std::size_t>
+  written(Assns<L, R> const& assns)
+  {
+    return {assns.ptr_data_1_.size(), assns.encoded_1_.size()};
+  }
+};
+
+namespace {
+  ProductID const intsID{2};
+  ProductID const floatsID{3};
+  ProductID const moreIntsID{4};
+
+  class TestGetter : public EDProductGetter {
+    EDProduct const*
+    getIt_() const override
+    {
+      return nullptr;
+    }
+  };
+
+  // Enables the compact form of Assns while in scope.
+  class CompactWrites {
+  public:
+    explicit CompactWrites(bool const enable)
+    {
+      art::detail::setCompactAssnsWrites(enable);
+    }
+    ~CompactWrites() { art::detail::setCompactAssnsWrites(false); }
+  };
+
+  // Simulates writing and then reading the product, in place.
+  template <typename A>
+  void
+  write_and_read(A& assns)
+  {
+    art::detail::AssnsBase& base = assns;
+    base.fill_from_transients();
+    base.fill_from_transients(); // Second output module.
+    base.fill_transients();
+  }
+
+  template <typename A, typename B>
+  bool
+  same_pairs(A const& a, B const& b)
+  {
+    if (a.size() != b.size()) {
+      return false;
+    }
+    for (std::size_t i{}; i != a.size(); ++i) {
+      if (a[i] != b[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(assns_encoding_t)
+
+BOOST_AUTO_TEST_CASE(column_round_trip)
+{
+  std::vector<RefCore> table;
+  std::vector<std::pair<ProductID, std::size_t>> const items{
+    {intsID, 0},
+    {intsID, 1},
+    {intsID, 1},
+    {moreIntsID, 7},
+    {intsID, 0},
+    {intsID, std::numeric_limits<std::size_t>::max()},
+    {intsID, 3}};
+
+  AssnsColumnEncoder encoder{table};
+  for (auto const& [id, key] : items) {
+    encoder.add(RefCore{id, nullptr, nullptr}, key);
+  }
+  auto const encoded = encoder.finish();
+  BOOST_TEST_REQUIRE(table.size() == 2u);
+  BOOST_TEST(table[0].id() == intsID);
+  BOOST_TEST(table[1].id() == moreIntsID);
+
+  AssnsColumnDecoder decoder{encoded, table.size()};
+  BOOST_TEST_REQUIRE(decoder.size() == items.size());
+  for (auto const& [id, key] : items) {
+    auto const [index, decoded_key] = decoder.next();
+    BOOST_TEST(table.at(index).id() == id);
+    BOOST_TEST(decoded_key == key);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(column_shares_table)
+{
+  std::vector<RefCore> table;
+  AssnsColumnEncoder e1{table};
+  e1.add(RefCore{intsID, nullptr, nullptr}, 0);
+  auto const c1 = e1.finish();
+  AssnsColumnEncoder e2{table};
+  e2.add(RefCore{floatsID, nullptr, nullptr}, 0);
+  e2.add(RefCore{intsID, nullptr, nullptr}, 0);
+  auto const c2 = e2.finish();
+  BOOST_TEST(table.size() == 2u);
+
+  AssnsColumnDecoder d1{c1, table.size()};
+  BOOST_TEST(d1.next().first == 0u);
+  AssnsColumnDecoder d2{c2, table.size()};
+  BOOST_TEST(d2.next().first == 1u);
+  BOOST_TEST(d2.next().first == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(column_is_compact)
+{
+  // Ascending keys in one product take one byte each, plus the header.
+  std::size_t const n{1000};
+  std::vector<RefCore> table;
+  AssnsColumnEncoder encoder{table};
+  for (std::size_t i{}; i != n; ++i) {
+    encoder.add(RefCore{intsID, nullptr, nullptr}, i);
+  }
+  auto const encoded = encoder.finish();
+  BOOST_TEST(encoded.size() <= n + 6);
+}
+
+BOOST_AUTO_TEST_CASE(column_corrupt)
+{
+  std::vector<RefCore> table;
+  AssnsColumnEncoder encoder{table};
+  encoder.add(RefCore{intsID, nullptr, nullptr}, 300);
+  encoder.add(RefCore{floatsID, nullptr, nullptr}, 1);
+  auto const encoded = encoder.finish();
+
+  BOOST_CHECK_THROW((AssnsColumnDecoder{encoded, 1}), art::Exception);
+  BOOST_CHECK_THROW((AssnsColumnDecoder{{}, table.size()}), art::Exception);
+  auto truncated = encoded;
+  truncated.pop_back();
+  AssnsColumnDecoder decoder{truncated, table.size()};
+  decoder.next();
+  BOOST_CHECK_THROW(decoder.next(), art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(written_form)
+{
+  TestGetter const getter;
+  Assns<int, float> assns;
+  assns.addSingle(Ptr<int>{intsID, 1, &getter},
+                  Ptr<float>{floatsID, 2, &getter});
+  art::detail::AssnsBase& base = assns;
+
+  // By default, the version 11 form, which older releases read.
+  BOOST_TEST(!art::detail::compactAssnsWrites());
+  auto legacy = assns;
+  static_cast<art::detail::AssnsBase&>(legacy).fill_from_transients();
+  BOOST_TEST(art::detail::AssnsStreamer::written(legacy).first == 1u);
+  BOOST_TEST(art::detail::AssnsStreamer::written(legacy).second == 0u);
+
+  CompactWrites const compact{true};
+  base.fill_from_transients();
+  BOOST_TEST(art::detail::AssnsStreamer::written(assns).first == 0u);
+  BOOST_TEST(art::detail::AssnsStreamer::written(assns).second > 0u);
+}
+
+BOOST_AUTO_TEST_CASE(assns_round_trip)
+{
+  TestGetter const getter;
+  Assns<int, float> original;
+  std::vector<std::size_t> const leftKeys{0, 0, 1, 3, 2};
+  std::vector<std::size_t> const rightKeys{5, 6, 7, 8, 1};
+  original.addMany(intsID, &getter, leftKeys, floatsID, &getter, rightKeys);
+  original.addSingle(Ptr<int>{moreIntsID, 9, &getter},
+                     Ptr<float>{floatsID, 0, &getter});
+
+  // Both written forms.
+  for (bool const compact : {false, true}) {
+    CompactWrites const writes{compact};
+    auto assns = original;
+    write_and_read(assns);
+    BOOST_TEST(same_pairs(assns, original));
+    BOOST_TEST(assns[5].first.id() == moreIntsID);
+    BOOST_TEST(assns[5].first.productGetter() == &getter);
+
+    // Partner, whose items are written in the opposite order.
+    Assns<float, int> partner{original};
+    write_and_read(partner);
+    BOOST_TEST_REQUIRE(partner.size() == original.size());
+    for (std::size_t i{}; i != partner.size(); ++i) {
+      BOOST_TEST((partner[i].first == original[i].second));
+      BOOST_TEST((partner[i].second == original[i].first));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(assns_round_trip_empty)
+{
+  for (bool const compact : {false, true}) {
+    CompactWrites const writes{compact};
+    Assns<int, float> assns;
+    write_and_read(assns);
+    BOOST_TEST(assns.size() == 0u);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,128 @@
+// vim: set sw=2:
+
+// Measure the throughput of filling an Assns<L, R> and an
+// Assns<L, R, D> with one association per right item, as a producer
+// of hit-to-cluster associations would:
+//
+//   - with addSingle and no reservation (the previous best practice);
+//   - with addSingle after reserve();
+//   - with the bulk, by-key addMany.
+//
+// Usage: assns_fill_bench [n-associations] [n-repetitions]
+//        (defaults 10^6 and 10)
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace art;
+using namespace std;
+
+namespace {
+
+  ProductID const clustersID{2};
+  ProductID const hitsID{3};
+
+  template <typename F>
+  double
+  fill_rate(unsigned const n, unsigned const repetitions, F fill)
+  {
+    double best{};
+    for (unsigned r{}; r != repetitions; ++r) {
+      auto const start = chrono::steady_clock::now();
+      auto const size = fill();
+      chrono::duration<double> const elapsed =
+        chrono::steady_clock::now() - start;
+      if (size != n) {
+        cerr << "Fill failure.\n";
+        exit(1);
+      }
+      best = max(best, n / elapsed.count() / 1e6);
+    }
+    return best;
+  }
+
+  void
+  report(string const& what, double const rate)
+  {
+    cout << left << setw(40) << what << right << setw(10) << rate
+         << " M assns/s\n";
+  }
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const n = argc > 1 ? atoi(argv[1]) : 1'000'000;
+  unsigned const repetitions = argc > 2 ? atoi(argv[2]) : 10;
+
+  // Ten hits per cluster.
+  vector<size_t> clusterKeys(n);
+  vector<size_t> hitKeys(n);
+  vector<float> data(n);
+  for (size_t i{}; i != n; ++i) {
+    clusterKeys[i] = i / 10;
+    hitKeys[i] = i;
+    data[i] = 0.1f * i;
+  }
+
+  report("Assns<L, R>, addSingle", fill_rate(n, repetitions, [&] {
+           Assns<int, float> assns;
+           for (size_t i{}; i != n; ++i) {
+             assns.addSingle(Ptr<int>{clustersID, clusterKeys[i], nullptr},
+                             Ptr<float>{hitsID, hitKeys[i], nullptr});
+           }
+           return assns.size();
+         }));
+  report("Assns<L, R>, reserve + addSingle", fill_rate(n, repetitions, [&] {
+           Assns<int, float> assns;
+           assns.reserve(n);
+           for (size_t i{}; i != n; ++i) {
+             assns.addSingle(Ptr<int>{clustersID, clusterKeys[i], nullptr},
+                             Ptr<float>{hitsID, hitKeys[i], nullptr});
+           }
+           return assns.size();
+         }));
+  report("Assns<L, R>, addMany by key", fill_rate(n, repetitions, [&] {
+           Assns<int, float> assns;
+           assns.addMany(
+             clustersID, nullptr, clusterKeys, hitsID, nullptr, hitKeys);
+           return assns.size();
+         }));
+
+  report("Assns<L, R, D>, addSingle", fill_rate(n, repetitions, [&] {
+           Assns<int, float, float> assns;
+           for (size_t i{}; i != n; ++i) {
+             assns.addSingle(Ptr<int>{clustersID, clusterKeys[i], nullptr},
+                             Ptr<float>{hitsID, hitKeys[i], nullptr},
+                             data[i]);
+           }
+           return assns.size();
+         }));
+  report("Assns<L, R, D>, reserve + addSingle",
+         fill_rate(n, repetitions, [&] {
+           Assns<int, float, float> assns;
+           assns.reserve(n);
+           for (size_t i{}; i != n; ++i) {
+             assns.addSingle(Ptr<int>{clustersID, clusterKeys[i], nullptr},
+                             Ptr<float>{hitsID, hitKeys[i], nullptr},
+                             data[i]);
+           }
+           return assns.size();
+         }));
+  report("Assns<L, R, D>, addMany by key", fill_rate(n, repetitions, [&] {
+           Assns<int, float, float> assns;
+           assns.addMany(
+             clustersID, nullptr, clusterKeys, hitsID, nullptr, hitKeys, data);
+           return assns.size();
+         }));
+}
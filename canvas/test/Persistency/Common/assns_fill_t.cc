@@ -0,0 +1,89 @@
+#define BOOST_TEST_MODULE (assns_fill_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <list>
+#include <vector>
+
+using namespace art;
+
+namespace {
+  ProductID const intsID{2};
+  ProductID const floatsID{3};
+
+  template <typename A, typename B>
+  bool
+  same_pairs(A const& a, B const& b)
+  {
+    if (a.size() != b.size()) {
+      return false;
+    }
+    for (std::size_t i{}; i != a.size(); ++i) {
+      if (a[i] != b[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(assns_fill_t)
+
+BOOST_AUTO_TEST_CASE(add_by_key)
+{
+  std::vector<std::size_t> const leftKeys{0, 0, 1, 3};
+  std::vector<unsigned> const rightKeys{5, 6, 7, 8};
+
+  Assns<int, float> byPtr;
+  for (std::size_t i{}; i != leftKeys.size(); ++i) {
+    byPtr.addSingle(Ptr<int>{intsID, leftKeys[i], nullptr},
+                    Ptr<float>{floatsID, rightKeys[i], nullptr});
+  }
+
+  Assns<int, float> byKey;
+  byKey.reserve(2);
+  byKey.addMany(intsID, nullptr, leftKeys, floatsID, nullptr, rightKeys);
+  BOOST_TEST(same_pairs(byKey, byPtr));
+  BOOST_TEST(byKey[3].first.key() == 3u);
+  BOOST_TEST(byKey[3].second.id() == floatsID);
+
+  // Appending to an existing collection
+  byKey.addMany(intsID, nullptr, leftKeys, floatsID, nullptr, rightKeys);
+  BOOST_TEST(byKey.size() == 2 * leftKeys.size());
+  BOOST_TEST((byKey[5] == byPtr[1]));
+}
+
+BOOST_AUTO_TEST_CASE(add_by_key_with_data)
+{
+  std::vector<std::size_t> const leftKeys{4, 1, 2};
+  std::list<std::size_t> const rightKeys{0, 1, 2};
+  std::vector<short> const data{10, 11, 12};
+
+  Assns<int, float, short> byPtr;
+  auto rightKey = rightKeys.begin();
+  for (std::size_t i{}; i != leftKeys.size(); ++i, ++rightKey) {
+    byPtr.addSingle(Ptr<int>{intsID, leftKeys[i], nullptr},
+                    Ptr<float>{floatsID, *rightKey, nullptr},
+                    data[i]);
+  }
+
+  Assns<int, float, short> byKey;
+  byKey.reserve(leftKeys.size());
+  byKey.addMany(
+    intsID, nullptr, leftKeys, floatsID, nullptr, rightKeys, data);
+  BOOST_TEST(same_pairs(byKey, byPtr));
+  for (std::size_t i{}; i != data.size(); ++i) {
+    BOOST_TEST(byKey.data(i) == data[i]);
+  }
+
+  byKey.index();
+  byKey.addMany(
+    intsID, nullptr, leftKeys, floatsID, nullptr, rightKeys, data);
+  BOOST_TEST(!byKey.has_index());
+  BOOST_TEST(byKey.size() == 6u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,162 @@
+// vim: set sw=2:
+
+// Measure the throughput of visiting the associations of an
+// Assns<L, R, D> group by group, as a consumer of track-to-hit
+// associations would:
+//
+//   - with art::for_each_group and art::for_each_group_with_left
+//     (range-v3 chunk_by views);
+//   - with AssnsGroups, including and excluding its construction;
+//   - with AssnsGroups, visiting the groups in random order, which
+//     the range-v3 views cannot do without a linear search.
+//
+// Only the keys of the Ptrs are used, so that the measurement is of the
+// grouping rather than of product lookup.
+//
+// Usage: assns_groups_bench [n-associations] [group-size] [n-repetitions]
+//        (defaults 10^6, 10 and 10)
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/AssnsAlgorithms.h"
+#include "canvas/Persistency/Common/AssnsGroups.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace art;
+using namespace std;
+
+namespace {
+
+  ProductID const tracksID{2};
+  ProductID const hitsID{3};
+
+  using assns_t = Assns<int, float, float>;
+
+  template <typename F>
+  double
+  visit_rate(unsigned const n,
+             unsigned const repetitions,
+             size_t const expected,
+             F visit)
+  {
+    double best{};
+    for (unsigned r{}; r != repetitions; ++r) {
+      auto const start = chrono::steady_clock::now();
+      auto const checksum = visit();
+      chrono::duration<double> const elapsed =
+        chrono::steady_clock::now() - start;
+      if (checksum != expected) {
+        cerr << "Visit failure.\n";
+        exit(1);
+      }
+      best = max(best, n / elapsed.count() / 1e6);
+    }
+    return best;
+  }
+
+  void
+  report(string const& what, double const rate)
+  {
+    cout << left << setw(44) << what << right << setw(10) << rate
+         << " M assns/s\n";
+  }
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const n = argc > 1 ? atoi(argv[1]) : 1'000'000;
+  unsigned const group_size = argc > 2 ? atoi(argv[2]) : 10;
+  unsigned const repetitions = argc > 3 ? atoi(argv[3]) : 10;
+
+  vector<size_t> trackKeys(n);
+  vector<size_t> hitKeys(n);
+  vector<float> data(n);
+  for (size_t i{}; i != n; ++i) {
+    trackKeys[i] = i / group_size;
+    hitKeys[i] = i;
+    data[i] = 0.1f * i;
+  }
+  assns_t assns;
+  assns.addMany(
+    tracksID, nullptr, trackKeys, hitsID, nullptr, hitKeys, data);
+
+  // Each visit sums (left key + 1) * right key over all associations.
+  size_t expected{};
+  for (size_t i{}; i != n; ++i) {
+    expected += (trackKeys[i] + 1) * hitKeys[i];
+  }
+
+  report("for_each_group", visit_rate(n, repetitions, expected, [&] {
+           size_t checksum{};
+           size_t left_key{};
+           for_each_group(assns, [&](auto rights) {
+             ++left_key;
+             for (auto const& right : rights) {
+               checksum += left_key * right.key();
+             }
+           });
+           return checksum;
+         }));
+  report("for_each_group_with_left",
+         visit_rate(n, repetitions, expected, [&] {
+           size_t checksum{};
+           for_each_group_with_left(assns, [&](auto const& left, auto rights) {
+             for (auto const& right : rights) {
+               checksum += (left.key() + 1) * right.key();
+             }
+           });
+           return checksum;
+         }));
+
+  auto const sum_group = [](auto const& group) {
+    size_t const left_key = group.left().key() + 1;
+    size_t checksum{};
+    for (Ptr<float> const& right : group.rights()) {
+      checksum += left_key * right.key();
+    }
+    return checksum;
+  };
+
+  report("AssnsGroups, with construction",
+         visit_rate(n, repetitions, expected, [&] {
+           AssnsGroups const groups{assns};
+           size_t checksum{};
+           for (auto const& group : groups) {
+             checksum += sum_group(group);
+           }
+           return checksum;
+         }));
+
+  AssnsGroups const groups{assns};
+  report("AssnsGroups, prebuilt", visit_rate(n, repetitions, expected, [&] {
+           size_t checksum{};
+           for (auto const& group : groups) {
+             checksum += sum_group(group);
+           }
+           return checksum;
+         }));
+
+  vector<size_t> order(groups.size());
+  iota(order.begin(), order.end(), 0);
+  shuffle(order.begin(), order.end(), mt19937{42});
+  report("AssnsGroups, prebuilt, random order",
+         visit_rate(n, repetitions, expected, [&] {
+           size_t checksum{};
+           for (auto const i : order) {
+             checksum += sum_group(groups.group(i));
+           }
+           return checksum;
+         }));
+}
@@ -0,0 +1,109 @@
+#define BOOST_TEST_MODULE (assns_groups_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/AssnsGroups.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+using namespace art;
+
+namespace {
+  ProductID const intsID{2};
+  ProductID const floatsID{3};
+
+  struct Fixture {
+    Fixture()
+    {
+      // Left item 0 appears in two separate runs; left item 2 in none.
+      std::size_t const lefts[]{1, 1, 1, 0, 3, 3, 0};
+      for (std::size_t i{}; i != std::size(lefts); ++i) {
+        auto const l = lefts[i];
+        Ptr<int> const left{intsID, &ints[l], l};
+        Ptr<float> const right{floatsID, &floats[i], i};
+        plain.addSingle(left, right);
+        assns.addSingle(left, right, static_cast<short>(10 * i));
+      }
+    }
+
+    std::vector<int> const ints{10, 11, 12, 13};
+    std::vector<float> const floats{0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f};
+    Assns<int, float> plain;
+    Assns<int, float, short> assns;
+  };
+
+  template <typename Group>
+  std::vector<float>
+  right_values(Group const& group)
+  {
+    std::vector<float> result;
+    for (Ptr<float> const& right : group.rights()) {
+      result.push_back(*right);
+    }
+    return result;
+  }
+}
+
+BOOST_FIXTURE_TEST_SUITE(assns_groups_t, Fixture)
+
+BOOST_AUTO_TEST_CASE(groups)
+{
+  AssnsGroups const groups{assns};
+  BOOST_TEST_REQUIRE(groups.size() == 4u);
+  std::vector<std::size_t> const offsets{0, 3, 4, 6, 7};
+  BOOST_TEST(std::ranges::equal(groups.offsets(), offsets));
+
+  std::vector<int> const lefts{11, 10, 13, 10};
+  std::vector<std::vector<float>> const rights{
+    {0.f, 1.f, 2.f}, {3.f}, {4.f, 5.f}, {6.f}};
+  for (std::size_t i{}; i != groups.size(); ++i) {
+    auto const group = groups.group(i);
+    BOOST_TEST(*group.left() == lefts[i]);
+    BOOST_TEST(group.first() == offsets[i]);
+    BOOST_TEST(group.size() == rights[i].size());
+    BOOST_TEST(right_values(group) == rights[i]);
+    auto const data = group.data();
+    BOOST_TEST_REQUIRE(data.size() == group.size());
+    for (std::size_t j{}; j != data.size(); ++j) {
+      BOOST_TEST(data[j] == assns.data(group.first() + j));
+      BOOST_TEST(&group.rights()[j] == &assns[group.first() + j].second);
+      BOOST_TEST(&group.pairs()[j] == &assns[group.first() + j]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(iteration)
+{
+  AssnsGroups const groups{plain};
+  static_assert(std::random_access_iterator<decltype(groups.begin())>);
+  static_assert(std::ranges::random_access_range<
+                decltype(groups.group(0).rights())>);
+  BOOST_TEST((groups.end() - groups.begin() == 4));
+  std::vector<std::size_t> sizes;
+  for (auto const& group : groups) {
+    sizes.push_back(group.size());
+  }
+  BOOST_TEST((sizes == std::vector<std::size_t>{3, 1, 2, 1}));
+  BOOST_TEST(right_values(groups.begin()[2]) ==
+             (std::vector<float>{4.f, 5.f}));
+  BOOST_TEST(*groups[3].rights().front() == 6.f);
+  BOOST_CHECK_THROW(groups.at(4), art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+  Assns<int, float> const none;
+  AssnsGroups const groups{none};
+  BOOST_TEST(groups.empty());
+  BOOST_TEST(groups.size() == 0u);
+  BOOST_TEST((groups.begin() == groups.end()));
+  BOOST_CHECK_THROW(groups.at(0), art::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,123 @@
+#define BOOST_TEST_MODULE (assns_index_t)
+#include "MockEvent.h"
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/detail/IPRHelper.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <vector>
+
+using namespace art;
+using arttest::MockEvent;
+
+namespace {
+
+  ProductID const intsID{2};
+  ProductID const floatsID{3};
+  ProductID const otherIntsID{4};
+
+  struct Fixture {
+    Fixture()
+    {
+      // Association order deliberately interleaves the left items.
+      unsigned const lefts[]{2, 0, 2, 1, 0, 2};
+      for (unsigned i{}; i != std::size(lefts); ++i) {
+        auto const l = lefts[i];
+        Ptr<int> const left{l < 3 ? intsID : otherIntsID, &ints[l], l};
+        Ptr<float> const right{floatsID, &floats[i], i};
+        assns.addSingle(left, right, static_cast<short>(10 * i));
+      }
+    }
+
+    std::vector<int> const ints{10, 11, 12, 13};
+    std::vector<float> const floats{0.f, 1.f, 2.f, 3.f, 4.f, 5.f};
+    Assns<int, float, short> assns;
+  };
+
+  template <typename Acoll, typename Assns>
+  auto
+  find_many(Acoll const& aColl, Assns const& assns)
+  {
+    using event_t = MockEvent<Assns>;
+    event_t const event{assns};
+    detail::IPRHelper<int,
+                      float,
+                      short,
+                      std::vector<std::vector<short const*>>,
+                      event_t> const helper{event, InputTag{"assns"}};
+    std::pair<std::vector<std::vector<float const*>>,
+              std::vector<std::vector<short const*>>>
+      result;
+    BOOST_TEST(!helper(aColl, result.first, result.second));
+    return result;
+  }
+}
+
+BOOST_FIXTURE_TEST_SUITE(assns_index_t, Fixture)
+
+BOOST_AUTO_TEST_CASE(lookup)
+{
+  BOOST_TEST(!assns.has_index());
+  auto const& index = assns.index();
+  BOOST_TEST(assns.has_index());
+  BOOST_TEST(&assns.index() == &index);
+
+  auto const indices = [](auto const entries) {
+    std::vector<std::size_t> result;
+    for (auto const& entry : entries) {
+      result.push_back(entry.index);
+    }
+    return result;
+  };
+  using Key = detail::AssnsIndex::Key;
+  using v = std::vector<std::size_t>;
+  BOOST_TEST(indices(index.by_left(Key{intsID, 0})) == (v{1, 4}));
+  BOOST_TEST(indices(index.by_left(Key{intsID, 1})) == (v{3}));
+  BOOST_TEST(indices(index.by_left(Key{intsID, 2})) == (v{0, 2, 5}));
+  BOOST_TEST(index.by_left(Key{intsID, 3}).empty());
+  BOOST_TEST(index.by_left(Key{otherIntsID, 0}).empty());
+  BOOST_TEST(indices(index.by_right(Key{floatsID, 4})) == (v{4}));
+  BOOST_TEST(index.by_right(Key{intsID, 4}).empty());
+  BOOST_TEST(indices(index.by_left()) == (v{1, 4, 3, 0, 2, 5}));
+  BOOST_TEST(indices(index.by_right()) == (v{0, 1, 2, 3, 4, 5}));
+}
+
+BOOST_AUTO_TEST_CASE(invalidation)
+{
+  assns.index();
+  auto copy = assns;
+  BOOST_TEST(!copy.has_index());
+
+  copy.index();
+  copy.addSingle(Ptr<int>{intsID, &ints[3], 3},
+                 Ptr<float>{floatsID, &floats[0], 0},
+                 short{60});
+  BOOST_TEST(!copy.has_index());
+  BOOST_TEST(copy.index().by_left({intsID, 3}).size() == 1u);
+
+  copy.swap(assns);
+  BOOST_TEST(!copy.has_index());
+  BOOST_TEST(!assns.has_index());
+  BOOST_TEST(assns.size() == 7u);
+}
+
+BOOST_AUTO_TEST_CASE(find_many_with_index)
+{
+  std::vector<Ptr<int>> aColl;
+  for (unsigned l : {2u, 3u, 0u, 1u, 2u}) {
+    aColl.emplace_back(intsID, &ints[l], l);
+  }
+  auto const expected = find_many(aColl, assns);
+  assns.index();
+  auto const indexed = find_many(aColl, assns);
+  BOOST_TEST_REQUIRE(indexed.first.size() == aColl.size());
+  BOOST_TEST((indexed == expected));
+  BOOST_TEST(indexed.first[0].size() == 3u);
+  BOOST_TEST(*indexed.first[0][1] == 2.f);
+  BOOST_TEST(*indexed.second[0][2] == 50);
+  BOOST_TEST(indexed.first[1].empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,116 @@
+// vim: set sw=2:
+
+// Compare PtrVector and CompactPtrVector holding the same elements:
+//
+//   - memory used by the elements, before and after their items have
+//     been resolved;
+//   - throughput of a first pass dereferencing every element, which
+//     resolves the items, and of later passes.
+//
+// Usage: compact_ptr_vector_bench [n-elements] [n-repetitions]
+//        (defaults 10^6 and 10)
+
+#include "MockEvent.h"
+#include "canvas/Persistency/Common/CompactPtrVector.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/PtrVector.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace art;
+using namespace std;
+using arttest::FloatsGetter;
+
+namespace {
+
+  ProductID const hitsID{3};
+
+  // Returns the best rates of the first and of later passes.
+  template <typename V, typename F>
+  pair<double, double>
+  pass_rates(V const& original, unsigned const repetitions, F pass)
+  {
+    double first{}, later{};
+    for (unsigned r{}; r != repetitions; ++r) {
+      auto const ptrs = original;
+      for (auto* best : {&first, &later}) {
+        auto const start = chrono::steady_clock::now();
+        auto const sum = pass(ptrs);
+        chrono::duration<double> const elapsed =
+          chrono::steady_clock::now() - start;
+        if (sum != ptrs.size()) {
+          cerr << "Dereference failure.\n";
+          exit(1);
+        }
+        *best = max(*best, ptrs.size() / elapsed.count() / 1e6);
+      }
+    }
+    return {first, later};
+  }
+
+  void
+  report(string const& what, pair<double, double> const rates)
+  {
+    cout << left << setw(36) << what << right << setw(10) << rates.first
+         << " M elements/s (first pass), " << setw(10) << rates.second
+         << " M elements/s (later passes)\n";
+  }
+
+  void
+  report_memory(string const& what, size_t const bytes, size_t const n)
+  {
+    cout << left << setw(36) << what << right << setw(10)
+         << static_cast<double>(bytes) / n << " bytes/element\n";
+  }
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const n = argc > 1 ? atoi(argv[1]) : 1'000'000;
+  unsigned const repetitions = argc > 2 ? atoi(argv[2]) : 10;
+
+  FloatsGetter const getter{vector<float>(n, 1.f)};
+  mt19937 engine{42};
+  uniform_int_distribution<size_t> key{0, n - 1};
+  PtrVector<float> ptrs;
+  ptrs.reserve(n);
+  for (unsigned i{}; i != n; ++i) {
+    ptrs.push_back(Ptr<float>{hitsID, key(engine), &getter});
+  }
+  CompactPtrVector<float> compact{ptrs};
+  compact.shrink_to_fit();
+
+  report_memory("PtrVector", n * sizeof(Ptr<float>), n);
+  report_memory("CompactPtrVector, unresolved",
+                n * sizeof(CompactPtrVector<float>::key_type),
+                n);
+  report_memory("CompactPtrVector, resolved",
+                n * (sizeof(CompactPtrVector<float>::key_type) +
+                     sizeof(float const*)),
+                n);
+
+  report("PtrVector", pass_rates(ptrs, repetitions, [](auto const& ptrs) {
+           float sum{};
+           for (auto const& p : ptrs) {
+             sum += *p;
+           }
+           return sum;
+         }));
+  report("CompactPtrVector",
+         pass_rates(compact, repetitions, [](auto const& ptrs) {
+           float sum{};
+           for (auto const p : ptrs) {
+             sum += *p;
+           }
+           return sum;
+         }));
+}
@@ -0,0 +1,151 @@
+#define BOOST_TEST_MODULE (compact_ptr_vector_t)
+#include "MockEvent.h"
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/CompactPtrVector.h"
+#include "canvas/Persistency/Common/EDProductGetter.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/PtrVector.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+using namespace art;
+using arttest::FloatsGetter;
+using arttest::MockGetter;
+using arttest::NoProductGetter;
+
+// Stands in for the streamer of the framework, which is granted access
+// to the persistent members of PtrVectorBase.
+class art::detail::PtrVectorBaseStreamer {
+public:
+  // Simulates writing and then reading the product, in place.
+  static void
+  write_and_read(PtrVectorBase& ptrs, EDProductGetter const* getter)
+  {
+    ptrs.fill_offsets(ptrs.indicies_);
+    auto const indices = ptrs.indicies_;
+    ptrs.zeroTransients();
+    ptrs.core_ = RefCore{ptrs.core_.id(), nullptr, getter};
+    ptrs.indicies_ = indices;
+    ptrs.fillPtrs();
+  }
+};
+
+namespace {
+
+  ProductID const floatsID{3};
+
+  struct Fixture {
+    Fixture()
+    {
+      for (std::size_t const key : {4, 0, 2, 2}) {
+        ptrs.push_back(Ptr<float>{floatsID, key, &getter});
+      }
+    }
+
+    FloatsGetter const getter{{0.f, 1.f, 2.f, 3.f, 4.f}};
+    PtrVector<float> ptrs;
+  };
+}
+
+BOOST_FIXTURE_TEST_SUITE(compact_ptr_vector_t, Fixture)
+
+BOOST_AUTO_TEST_CASE(same_as_ptr_vector)
+{
+  CompactPtrVector<float> const compact{ptrs};
+  BOOST_TEST(compact.id() == floatsID);
+  BOOST_TEST_REQUIRE(compact.size() == ptrs.size());
+  static_assert(std::random_access_iterator<decltype(compact.begin())>);
+  BOOST_TEST(std::distance(compact.begin(), compact.end()) == 4);
+
+  // All items are found upon the first access.
+  for (std::size_t i{}; i != ptrs.size(); ++i) {
+    BOOST_TEST((compact[i] == ptrs[i]));
+    BOOST_TEST(compact.key(i) == ptrs[i].key());
+    BOOST_TEST(compact[i].refCore().productPtr() != nullptr);
+  }
+  BOOST_TEST(getter.calls() == 1u);
+  BOOST_TEST(*compact.get(0) == 4.f);
+  std::vector<float> values;
+  for (auto const& p : compact) {
+    values.push_back(*p);
+  }
+  BOOST_TEST((values == std::vector<float>{4.f, 0.f, 2.f, 2.f}));
+  BOOST_TEST(compact.get(2) == compact.get(3));
+  BOOST_TEST(getter.calls() == 1u);
+
+  BOOST_CHECK_THROW(compact.at(4), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(resolved_items_kept)
+{
+  // Items given by pointer have no getter to be found with.
+  float const item{42.f};
+  CompactPtrVector<float> compact;
+  compact.push_back(Ptr<float>{floatsID, &item, 7});
+  compact.push_back(Ptr<float>{floatsID, 1, &getter});
+  BOOST_TEST(compact[0].get() == &item);
+  BOOST_TEST(*compact.get(1) == 1.f);
+  BOOST_TEST(compact.get(0) == &item);
+
+  compact.pop_back();
+  BOOST_TEST(compact.size() == 1u);
+  compact.clear();
+  BOOST_TEST(compact.empty());
+  BOOST_TEST(compact.isNull());
+}
+
+BOOST_AUTO_TEST_CASE(read)
+{
+  CompactPtrVector<float> compact{ptrs};
+  auto const expected = compact;
+  FloatsGetter const reader{{0.f, 1.f, 2.f, 3.f, 4.f}};
+  detail::PtrVectorBaseStreamer::write_and_read(compact, &reader);
+
+  BOOST_TEST((compact == expected));
+  BOOST_TEST(compact.productGetter() == &reader);
+  BOOST_TEST(*compact.get(0) == 4.f);
+  BOOST_TEST(reader.calls() == 1u);
+  BOOST_TEST(getter.calls() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(missing_product)
+{
+  CompactPtrVector<float> compact;
+  compact.push_back(Ptr<float>{floatsID, 0, nullptr});
+  BOOST_TEST(compact[0].refCore().productPtr() == nullptr);
+  BOOST_CHECK_THROW(compact.get(0), art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(failed_lookup)
+{
+  // The product is looked up once; the unresolved Ptrs report the
+  // failure upon dereference.
+  NoProductGetter const noProduct;
+  CompactPtrVector<float> compact;
+  for (std::size_t const key : {0, 1, 2}) {
+    compact.push_back(Ptr<float>{floatsID, key, &noProduct});
+  }
+  for (auto const& p : compact) {
+    BOOST_TEST(p.refCore().productPtr() == nullptr);
+    BOOST_TEST(p.productGetter() == &noProduct);
+  }
+  BOOST_TEST(noProduct.calls() == 1u);
+  BOOST_CHECK_THROW(compact.get(0), art::Exception);
+
+  // A product of the wrong type cannot provide the items.
+  MockGetter<int> const wrongType{1};
+  CompactPtrVector<float> mismatched;
+  mismatched.push_back(Ptr<float>{floatsID, 0, &wrongType});
+  BOOST_TEST(mismatched[0].refCore().productPtr() == nullptr);
+  BOOST_TEST(mismatched[0].refCore().productPtr() == nullptr);
+  BOOST_TEST(wrongType.calls() == 1u);
+  BOOST_CHECK_THROW(*mismatched[0], art::Exception);
+  BOOST_CHECK_THROW(mismatched.get(0), art::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
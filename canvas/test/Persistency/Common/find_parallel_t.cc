@@ -0,0 +1,154 @@
+#define BOOST_TEST_MODULE (find_parallel_t)
+#include "MockEvent.h"
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/QueryPolicy.h"
+#include "canvas/Persistency/Common/detail/IPRHelper.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace art;
+using arttest::MockEvent;
+
+namespace {
+
+  ProductID const intsID{2};
+  ProductID const floatsID{3};
+  ProductID const missingID{4};
+
+  using assns_t = Assns<int, float, short>;
+  using data_t = std::vector<std::vector<short const*>>;
+
+  template <typename Bcoll, typename Acoll>
+  std::pair<Bcoll, data_t>
+  find(Acoll const& aColl, assns_t const& assns, QueryPolicy const policy)
+  {
+    using event_t = MockEvent<assns_t>;
+    event_t const event{assns};
+    detail::IPRHelper<int, float, short, data_t, event_t> const helper{
+      event, InputTag{"assns"}, policy};
+    std::pair<Bcoll, data_t> result;
+    BOOST_TEST(!helper(aColl, result.first, result.second));
+    return result;
+  }
+
+  template <typename Bcoll, typename Acoll>
+  void
+  check_same(Acoll const& aColl, assns_t const& assns)
+  {
+    auto const expected = find<Bcoll>(aColl, assns, QueryPolicy::sequential);
+    auto const parallel = find<Bcoll>(aColl, assns, QueryPolicy::parallel);
+    BOOST_TEST((parallel == expected));
+  }
+
+  // Enough items that the work is split between tasks.
+  struct Fixture {
+    Fixture()
+    {
+      std::mt19937 engine{42};
+      std::uniform_int_distribution<std::size_t> left{0, n_ints - 1};
+      for (std::size_t i{}; i != n_floats; ++i) {
+        auto const l = left(engine);
+        // Some right items refer to a product that is not available.
+        Ptr<float> const right = (i % 97 == 0) ?
+                                   Ptr<float>{missingID, i, nullptr} :
+                                   Ptr<float>{floatsID, &floats[i], i};
+        assns.addSingle(Ptr<int>{intsID, &ints[l], l},
+                        right,
+                        static_cast<short>(i % 1000));
+      }
+      for (std::size_t l{}; l < n_ints; l += 3) {
+        aPtrs.emplace_back(intsID, &ints[l], l);
+        aPointers.push_back(&ints[l]);
+      }
+      // Repeated reference items.
+      aPtrs.push_back(aPtrs.front());
+      aPointers.push_back(aPointers.front());
+    }
+
+    static constexpr std::size_t n_ints{20000};
+    static constexpr std::size_t n_floats{50000};
+    std::vector<int> const ints = std::vector<int>(n_ints);
+    std::vector<float> const floats = std::vector<float>(n_floats);
+    assns_t assns;
+    std::vector<Ptr<int>> aPtrs;
+    std::vector<int const*> aPointers;
+  };
+
+  template <typename F>
+  std::string
+  what_thrown(F f)
+  {
+    try {
+      f();
+    }
+    catch (art::Exception const& e) {
+      return e.what();
+    }
+    return {};
+  }
+}
+
+BOOST_FIXTURE_TEST_SUITE(find_parallel_t, Fixture)
+
+BOOST_AUTO_TEST_CASE(find_many)
+{
+  using pointers_t = std::vector<std::vector<float const*>>;
+  using ptrs_t = std::vector<std::vector<Ptr<float>>>;
+  check_same<pointers_t>(aPtrs, assns);
+  check_same<pointers_t>(aPointers, assns);
+  check_same<ptrs_t>(aPtrs, assns);
+  assns.index();
+  check_same<pointers_t>(aPtrs, assns);
+  check_same<ptrs_t>(aPtrs, assns);
+
+  auto const result =
+    find<pointers_t>(aPtrs, assns, QueryPolicy::parallel).first;
+  BOOST_TEST_REQUIRE(result.size() == aPtrs.size());
+  BOOST_TEST(result.front() == result.back());
+}
+
+BOOST_AUTO_TEST_CASE(find_one)
+{
+  // One-to-one.
+  assns_t oneToOne;
+  std::vector<Ptr<int>> aColl;
+  for (std::size_t l{}; l != n_ints; ++l) {
+    oneToOne.addSingle(Ptr<int>{intsID, &ints[l], l},
+                       Ptr<float>{floatsID, &floats[l], l},
+                       short{});
+    aColl.emplace_back(intsID, &ints[l], l);
+  }
+  using pointers_t = std::vector<float const*>;
+  using ptrs_t = std::vector<Ptr<float>>;
+  check_same<pointers_t>(aColl, oneToOne);
+  check_same<ptrs_t>(aColl, oneToOne);
+
+  // Whichever error comes first in the reference collection is
+  // reported: here, an unavailable item rather than a one-to-many
+  // association.
+  assns_t broken;
+  for (std::size_t l{}; l != n_ints; ++l) {
+    broken.addSingle(Ptr<int>{intsID, &ints[l], l},
+                     l == 9000 ? Ptr<float>{missingID, l, nullptr} :
+                                 Ptr<float>{floatsID, &floats[l], l},
+                     short{});
+  }
+  broken.addSingle(Ptr<int>{intsID, &ints[15000], 15000},
+                   Ptr<float>{floatsID, &floats[0], 0},
+                   short{});
+  broken.index();
+  for (auto const policy : {QueryPolicy::sequential, QueryPolicy::parallel}) {
+    auto const what = what_thrown(
+      [&] { find<pointers_t>(aColl, broken, policy); });
+    BOOST_TEST(what.find("unavailable") != std::string::npos);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+#define BOOST_TEST_MODULE (lazy_find_many_t)
+#include "MockEvent.h"
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/LazyFindMany.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/detail/IPRHelper.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <vector>
+
+using namespace art;
+using arttest::FloatsGetter;
+using arttest::MockEvent;
+
+namespace {
+
+  ProductID const intsID{2};
+  ProductID const floatsID{3};
+
+  using assns_t = Assns<int, float, short>;
+  using event_t = MockEvent<assns_t>;
+
+  struct Fixture {
+    Fixture()
+    {
+      // Association order deliberately interleaves the left items.
+      unsigned const lefts[]{2, 0, 2, 1, 0, 2};
+      for (unsigned i{}; i != std::size(lefts); ++i) {
+        auto const l = lefts[i];
+        assns.addSingle(Ptr<int>{intsID, &ints[l], l},
+                        Ptr<float>{floatsID, i, &getter},
+                        static_cast<short>(10 * i));
+      }
+      for (unsigned l : {2u, 3u, 0u, 1u, 2u}) {
+        aColl.emplace_back(intsID, &ints[l], l);
+      }
+    }
+
+    bool
+    resolved(std::size_t const i) const
+    {
+      return assns[i].second.refCore().productPtr() != nullptr;
+    }
+
+    std::vector<int> const ints{10, 11, 12, 13};
+    FloatsGetter const getter{{0.f, 1.f, 2.f, 3.f, 4.f, 5.f}};
+    assns_t assns;
+    event_t const event{assns};
+    std::vector<Ptr<int>> aColl;
+  };
+
+  auto
+  find_many(std::vector<Ptr<int>> const& aColl, event_t const& event)
+  {
+    using data_t = std::vector<std::vector<short const*>>;
+    detail::IPRHelper<int, float, short, data_t, event_t> const helper{
+      event, InputTag{"assns"}};
+    std::pair<std::vector<std::vector<float const*>>, data_t> result;
+    BOOST_TEST(!helper(aColl, result.first, result.second));
+    return result;
+  }
+}
+
+BOOST_FIXTURE_TEST_SUITE(lazy_find_many_t, Fixture)
+
+BOOST_AUTO_TEST_CASE(resolves_on_access)
+{
+  LazyFindMany<float, short> const lazy{aColl, event, InputTag{"assns"}};
+  BOOST_TEST_REQUIRE(lazy.size() == aColl.size());
+  for (std::size_t i{}; i != assns.size(); ++i) {
+    BOOST_TEST(!resolved(i));
+  }
+
+  // Item 3 (left key 1) has association 3 only.
+  auto const& items = lazy.at(3);
+  BOOST_TEST_REQUIRE(items.size() == 1u);
+  BOOST_TEST(*items[0] == 3.f);
+  BOOST_TEST(*lazy.data(3)[0] == 30);
+  for (std::size_t i{}; i != assns.size(); ++i) {
+    BOOST_TEST(resolved(i) == (i == 3));
+  }
+  BOOST_TEST(&lazy.at(3) == &items);
+
+  BOOST_CHECK_THROW(lazy.at(aColl.size()), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(same_as_find_many)
+{
+  for (auto const indexed : {false, true}) {
+    if (indexed) {
+      assns.index();
+    }
+    for (auto const policy :
+         {QueryPolicy::sequential, QueryPolicy::parallel}) {
+      LazyFindMany<float, short> const lazy{
+        aColl, event, InputTag{"assns"}, policy};
+      auto const expected = find_many(aColl, event);
+      BOOST_TEST_REQUIRE(lazy.size() == expected.first.size());
+      for (std::size_t i{}; i != lazy.size(); ++i) {
+        BOOST_TEST((lazy.at(i) == expected.first[i]));
+        BOOST_TEST((lazy.data(i) == expected.second[i]));
+        std::vector<float const*> items;
+        std::vector<short const*> data;
+        BOOST_TEST(lazy.get(i, items, data) == expected.first[i].size());
+        BOOST_TEST((items == expected.first[i]));
+        BOOST_TEST((data == expected.second[i]));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(without_data)
+{
+  Assns<int, float> plain;
+  for (std::size_t i{}; i != assns.size(); ++i) {
+    plain.addSingle(assns[i].first, assns[i].second);
+  }
+  MockEvent<Assns<int, float>> const plainEvent{plain};
+  std::vector<int const*> aPointers{&ints[2], &ints[3]};
+  LazyFindMany<float> const lazy{aPointers, plainEvent, InputTag{"assns"}};
+  BOOST_TEST(lazy.at(0).size() == 3u);
+  BOOST_TEST(lazy.at(1).empty());
+}
+
+BOOST_AUTO_TEST_CASE(invalid)
+{
+  event_t const noEvent{nullptr};
+  LazyFindMany<float, short> const lazy{aColl, noEvent, InputTag{"assns"}};
+  BOOST_TEST(!lazy.isValid());
+  BOOST_CHECK_THROW(lazy.size(), art::Exception);
+  BOOST_CHECK_THROW(lazy.at(0), art::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
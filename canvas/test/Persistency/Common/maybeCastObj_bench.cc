@@ -0,0 +1,107 @@
+// vim: set sw=2:
+
+// Measure the cost of detail::maybeCastObj, as called for each element
+// by getElementAddresses for a Ptr<Base> or View<Base> into a
+// collection of derived objects, for:
+//
+//   - single inheritance;
+//   - the second base of a class with multiple inheritance;
+//   - a virtual base.
+//
+// A native upcast of the same elements is timed for reference.
+//
+// Usage: maybeCastObj_bench [n-elements] [n-repetitions]
+//        (defaults 10^6 and 10)
+
+#include "canvas/Persistency/Common/detail/maybeCastObj.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+using namespace art;
+using namespace std;
+
+namespace {
+
+  struct Base {
+    virtual ~Base() = default;
+    long value{1};
+  };
+  struct Other {
+    virtual ~Other() = default;
+    long other{2};
+  };
+
+  struct Single : Base {
+    long single{3};
+  };
+  struct Multiple : Other, Base {
+    long multiple{4};
+  };
+  struct Virtual : Other, virtual Base {
+    long virtual_{5};
+  };
+
+  template <typename F>
+  double
+  cast_time(unsigned const n, unsigned const repetitions, F cast_all)
+  {
+    double best{-1.};
+    for (unsigned r{}; r != repetitions; ++r) {
+      auto const start = chrono::steady_clock::now();
+      auto const sum = cast_all();
+      chrono::duration<double> const elapsed =
+        chrono::steady_clock::now() - start;
+      if (sum != n) {
+        cerr << "Cast failure.\n";
+        exit(1);
+      }
+      auto const ns = elapsed.count() / n * 1e9;
+      best = (best < 0. || ns < best) ? ns : best;
+    }
+    return best;
+  }
+
+  template <typename Derived>
+  void
+  measure(string const& what, unsigned const n, unsigned const repetitions)
+  {
+    vector<Derived> const elements(n);
+    auto const native = cast_time(n, repetitions, [&elements] {
+      long sum{};
+      for (auto const& element : elements) {
+        Base const* base = &element;
+        sum += base->value;
+      }
+      return static_cast<unsigned>(sum);
+    });
+    auto const erased = cast_time(n, repetitions, [&elements] {
+      long sum{};
+      for (auto const& element : elements) {
+        auto const base = static_cast<Base const*>(
+          detail::maybeCastObj(&element, typeid(Base)));
+        sum += base->value;
+      }
+      return static_cast<unsigned>(sum);
+    });
+    cout << left << setw(24) << what << right << setw(10) << erased
+         << " ns/cast (native: " << native << " ns/cast)\n";
+  }
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const n = argc > 1 ? atoi(argv[1]) : 1'000'000;
+  unsigned const repetitions = argc > 2 ? atoi(argv[2]) : 10;
+
+  measure<Single>("Single inheritance", n, repetitions);
+  measure<Multiple>("Multiple inheritance", n, repetitions);
+  measure<Virtual>("Virtual inheritance", n, repetitions);
+}
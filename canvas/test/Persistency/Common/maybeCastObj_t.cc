@@ -4,6 +4,7 @@
 #include <string>
 
 #include "canvas/Persistency/Common/detail/maybeCastObj.h"
+#include "canvas/Utilities/Exception.h"
 namespace {
   // Helper function
   template <typename T, typename U>
@@ -66,7 +67,31 @@ namespace {
   // Multiple
   class MCConcreteMultiple : public MCBase, public MCOtherBase {};
 
-  // Ambiguous?
+  // Ambiguous
+  class MCAmbiguous : public MCConcreteMultiple, public MCConcrete {};
+
+  // Virtual inheritance, diamond-shaped
+  struct MCVirtualBase {
+    int value{1};
+  };
+  struct MCVirtualLeft : virtual MCVirtualBase {
+    int left{2};
+  };
+  struct MCVirtualRight : virtual MCVirtualBase {
+    int right{3};
+  };
+  struct MCDiamond : MCOtherBase, MCVirtualLeft, MCVirtualRight {
+    int diamond{4};
+  };
+
+  // Helper function
+  template <typename T, typename U>
+  U const*
+  runMaybeCastObj(T const& t)
+  {
+    return static_cast<U const*>(
+      art::detail::maybeCastObj(&t, typeid(T), typeid(U)));
+  }
 }
 
 BOOST_AUTO_TEST_SUITE(maybeCastObj_t)
@@ -141,4 +166,43 @@ BOOST_AUTO_TEST_CASE(user_type_variables)
     typeid(refToBaseVirtual), typeid(MCConcreteVirtual_B))));
 }
 
+BOOST_AUTO_TEST_CASE(casts)
+{
+  // Repeated casts use the cached path.
+  for (int i{}; i != 2; ++i) {
+    MCConcreteMultiple const multiple{};
+    BOOST_TEST((runMaybeCastObj<MCConcreteMultiple, MCOtherBase>(multiple) ==
+                static_cast<MCOtherBase const*>(&multiple)));
+    BOOST_TEST((runMaybeCastObj<MCConcreteMultiple, MCBase>(multiple) ==
+                static_cast<MCBase const*>(&multiple)));
+
+    MCConcreteVirtual_C const c{};
+    BOOST_TEST((runMaybeCastObj<MCConcreteVirtual_C, MCConcrete>(c) ==
+                static_cast<MCConcrete const*>(&c)));
+    BOOST_TEST((runMaybeCastObj<MCConcreteVirtual_C, MCBaseVirtual>(c) ==
+                static_cast<MCBaseVirtual const*>(&c)));
+
+    // Virtual bases are located through the object.
+    MCDiamond const diamond{};
+    auto const base = runMaybeCastObj<MCDiamond, MCVirtualBase>(diamond);
+    BOOST_TEST(base == static_cast<MCVirtualBase const*>(&diamond));
+    BOOST_TEST(base->value == 1);
+    BOOST_TEST((runMaybeCastObj<MCDiamond, MCVirtualRight>(diamond)->right ==
+                3));
+    MCVirtualRight const right{};
+    BOOST_TEST((runMaybeCastObj<MCVirtualRight, MCVirtualBase>(right) ==
+                static_cast<MCVirtualBase const*>(&right)));
+  }
+  BOOST_TEST((runUpcastAllowed<MCDiamond, MCVirtualBase>()));
+  BOOST_TEST((!runUpcastAllowed<MCAmbiguous, MCBase>()));
+
+  MCAmbiguous const ambiguous{};
+  BOOST_CHECK_THROW((runMaybeCastObj<MCAmbiguous, MCBase>(ambiguous)),
+                    art::Exception);
+  BOOST_CHECK_THROW((runMaybeCastObj<MCConcrete, MCOtherBase>(MCConcrete{})),
+                    art::Exception);
+  BOOST_TEST(art::detail::maybeCastObj(static_cast<MCDiamond const*>(nullptr),
+                                       typeid(MCVirtualBase)) == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+#define BOOST_TEST_MODULE (prefetch_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/EDProductGetter.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/PtrVector.h"
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Persistency/Common/resolve.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace art;
+
+namespace {
+
+  // Records the calls made to each getter, in order.
+  std::vector<std::string> calls;
+
+  class RecordingGetter : public EDProductGetter {
+  public:
+    explicit RecordingGetter(std::string name, bool const present = true)
+      : name_{std::move(name)}
+    {
+      if (present) {
+        wrapper_ = std::make_unique<Wrapper<std::vector<int>>>(
+          std::make_unique<std::vector<int>>(std::vector<int>{1, 2, 3}));
+      }
+    }
+
+  private:
+    EDProduct const*
+    getIt_() const override
+    {
+      calls.push_back("get " + name_);
+      if (!wrapper_) {
+        throw Exception(errors::ProductNotFound) << name_ << '\n';
+      }
+      return wrapper_.get();
+    }
+
+    void
+    prefetch_() const override
+    {
+      calls.push_back("prefetch " + name_);
+    }
+
+    std::string name_;
+    std::unique_ptr<Wrapper<std::vector<int>>> wrapper_{};
+  };
+
+  class DefaultGetter : public EDProductGetter {};
+
+  ProductID const id1{2};
+  ProductID const id2{3};
+
+  struct Fixture {
+    Fixture() { calls.clear(); }
+
+    RecordingGetter const g1{"1"};
+    RecordingGetter const g2{"2"};
+  };
+}
+
+BOOST_FIXTURE_TEST_SUITE(prefetch_t, Fixture)
+
+BOOST_AUTO_TEST_CASE(defaults)
+{
+  DefaultGetter const getter;
+  getter.prefetch();
+  BOOST_TEST(getter.getItAsync().get() == nullptr);
+
+  auto product = g1.getItAsync();
+  BOOST_TEST(product.get() == g1.getIt());
+  RecordingGetter const missing{"missing", false};
+  auto failed = missing.getItAsync();
+  BOOST_CHECK_THROW(failed.get(), art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(ptr_vector)
+{
+  PtrVector<int> ptrs;
+  ptrs.prefetch();
+  BOOST_TEST(calls.empty());
+
+  ptrs.push_back(Ptr<int>{id1, 0, &g1});
+  ptrs.push_back(Ptr<int>{id1, 2, &g1});
+  ptrs.prefetch();
+  BOOST_TEST((calls == std::vector<std::string>{"prefetch 1"}));
+}
+
+BOOST_AUTO_TEST_CASE(assns)
+{
+  int const left{4};
+  float const right{5.f};
+  Assns<int, float, short> assns;
+  assns.addSingle(Ptr<int>{id1, 0, &g1}, Ptr<float>{id2, 0, &g2}, 0);
+  assns.addSingle(Ptr<int>{id1, 1, &g1}, Ptr<float>{id2, 1, &g2}, 1);
+  assns.addSingle(Ptr<int>{id1, 2, &g1}, Ptr<float>{id2, &right, 2}, 2);
+  assns.addSingle(Ptr<int>{id1, 0, &g1}, Ptr<float>{id2, 2, &g2}, 3);
+  assns.prefetch();
+  BOOST_TEST((calls == std::vector<std::string>{"prefetch 1", "prefetch 2"}));
+
+  // Nothing to fetch.
+  Assns<int, float> fetched;
+  fetched.addSingle(Ptr<int>{id1, &left, 0}, Ptr<float>{id2, &right, 0});
+  calls.clear();
+  fetched.prefetch();
+  BOOST_TEST(calls.empty());
+}
+
+BOOST_AUTO_TEST_CASE(resolve_prefetches)
+{
+  std::vector<Ptr<int>> const ptrs{
+    {id1, 0, &g1}, {id2, 1, &g2}, {id1, 2, &g1}};
+  std::vector<int const*> items;
+  resolve(ptrs, items);
+  BOOST_TEST((calls == std::vector<std::string>{
+                         "prefetch 1", "prefetch 2", "get 1", "get 2"}));
+  BOOST_TEST(*items[1] == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
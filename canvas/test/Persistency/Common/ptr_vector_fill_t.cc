@@ -0,0 +1,97 @@
+#define BOOST_TEST_MODULE (ptr_vector_fill_t)
+#include "MockEvent.h"
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/EDProductGetter.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/PtrVector.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <vector>
+
+using namespace art;
+using arttest::FloatsGetter;
+using arttest::MockGetter;
+
+// Stands in for the streamer of the framework, which is granted access
+// to the persistent members of PtrVectorBase.
+class art::detail::PtrVectorBaseStreamer {
+public:
+  // Simulates writing and then reading the product, in place.
+  static void
+  write_and_read(PtrVectorBase& ptrs, EDProductGetter const* getter)
+  {
+    ptrs.fill_offsets(ptrs.indicies_);
+    auto const indices = ptrs.indicies_;
+    ptrs.zeroTransients();
+    ptrs.core_ = RefCore{ptrs.core_.id(), nullptr, getter};
+    ptrs.indicies_ = indices;
+    ptrs.fillPtrs();
+  }
+};
+
+namespace {
+
+  ProductID const floatsID{3};
+
+  std::vector<float>
+  floats()
+  {
+    return {0.f, 1.f, 2.f, 3.f};
+  }
+
+  PtrVector<float>
+  make_ptrs(EDProductGetter const* getter)
+  {
+    PtrVector<float> ptrs;
+    for (std::size_t const key : {3, 1, 1}) {
+      ptrs.push_back(Ptr<float>{floatsID, key, getter});
+    }
+    return ptrs;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(ptr_vector_fill_t)
+
+BOOST_AUTO_TEST_CASE(ready_product)
+{
+  FloatsGetter const getter{floats(), true};
+  auto ptrs = make_ptrs(&getter);
+  auto const expected = ptrs;
+  detail::PtrVectorBaseStreamer::write_and_read(ptrs, &getter);
+
+  BOOST_TEST_REQUIRE(ptrs.size() == 3u);
+  BOOST_TEST((ptrs == expected));
+  for (auto const& p : ptrs) {
+    BOOST_TEST(p.refCore().productPtr() != nullptr);
+    BOOST_TEST(p.productGetter() == &getter);
+  }
+  BOOST_TEST(*ptrs[0] == 3.f);
+  BOOST_TEST(ptrs[1].get() == ptrs[2].get());
+  BOOST_TEST(getter.calls() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(product_not_ready)
+{
+  FloatsGetter const getter{floats(), false};
+  auto ptrs = make_ptrs(&getter);
+  detail::PtrVectorBaseStreamer::write_and_read(ptrs, &getter);
+
+  for (auto const& p : ptrs) {
+    BOOST_TEST(p.refCore().productPtr() == nullptr);
+  }
+  BOOST_TEST(*ptrs[0] == 3.f);
+  BOOST_TEST(getter.calls() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(product_without_ptr_support)
+{
+  // Errors are reported upon dereference only.
+  MockGetter<int> const getter{1, true};
+  auto ptrs = make_ptrs(&getter);
+  detail::PtrVectorBaseStreamer::write_and_read(ptrs, &getter);
+  BOOST_TEST(ptrs.size() == 3u);
+  BOOST_TEST(ptrs[0].refCore().productPtr() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+// vim: set sw=2:
+
+// Measure the throughput of resolving a vector of Ptrs that spans a few
+// products:
+//
+//   - one Ptr at a time, with Ptr::get();
+//   - all at once, with art::resolve.
+//
+// Each repetition starts from unresolved copies of the Ptrs.
+//
+// Usage: resolve_bench [n-ptrs] [n-products] [n-repetitions]
+//        (defaults 10^6, 4 and 10)
+
+#include "MockEvent.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/resolve.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace art;
+using namespace std;
+using arttest::FloatsGetter;
+
+namespace {
+
+  template <typename F>
+  double
+  resolve_rate(vector<Ptr<float>> const& ptrs,
+               unsigned const repetitions,
+               F resolve_all)
+  {
+    double best{};
+    for (unsigned r{}; r != repetitions; ++r) {
+      auto const copies = ptrs;
+      auto const start = chrono::steady_clock::now();
+      auto const sum = resolve_all(copies);
+      chrono::duration<double> const elapsed =
+        chrono::steady_clock::now() - start;
+      if (sum != ptrs.size()) {
+        cerr << "Resolution failure.\n";
+        exit(1);
+      }
+      best = max(best, ptrs.size() / elapsed.count() / 1e6);
+    }
+    return best;
+  }
+
+  void
+  report(string const& what, double const rate)
+  {
+    cout << left << setw(40) << what << right << setw(10) << rate
+         << " M Ptrs/s\n";
+  }
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const n = argc > 1 ? atoi(argv[1]) : 1'000'000;
+  unsigned const n_products = argc > 2 ? atoi(argv[2]) : 4;
+  unsigned const repetitions = argc > 3 ? atoi(argv[3]) : 10;
+
+  size_t const product_size = n / n_products + 1;
+  vector<unique_ptr<FloatsGetter>> getters;
+  for (unsigned p{}; p != n_products; ++p) {
+    getters.push_back(
+      make_unique<FloatsGetter>(vector<float>(product_size, 1.f)));
+  }
+
+  // Runs of Ptrs into the same product, in random order within each.
+  mt19937 engine{42};
+  uniform_int_distribution<size_t> key{0, product_size - 1};
+  uniform_int_distribution<unsigned> product{0, n_products - 1};
+  uniform_int_distribution<unsigned> run_length{1, 100};
+  vector<Ptr<float>> ptrs;
+  ptrs.reserve(n);
+  while (ptrs.size() != n) {
+    auto const p = product(engine);
+    for (auto i = run_length(engine); i != 0 && ptrs.size() != n; --i) {
+      ptrs.emplace_back(ProductID{p + 2}, key(engine), getters[p].get());
+    }
+  }
+
+  report("Ptr::get", resolve_rate(ptrs, repetitions, [](auto const& ptrs) {
+           float sum{};
+           for (auto const& ptr : ptrs) {
+             sum += *ptr.get();
+           }
+           return sum;
+         }));
+  report("art::resolve",
+         resolve_rate(ptrs, repetitions, [](auto const& ptrs) {
+           vector<float const*> items;
+           resolve(ptrs, items);
+           float sum{};
+           for (auto const item : items) {
+             sum += *item;
+           }
+           return sum;
+         }));
+}
@@ -0,0 +1,87 @@
+#define BOOST_TEST_MODULE (resolve_t)
+#include "MockEvent.h"
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/resolve.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <span>
+#include <vector>
+
+using namespace art;
+using arttest::FloatsGetter;
+using arttest::NoProductGetter;
+
+namespace {
+
+  ProductID const id1{2};
+  ProductID const id2{3};
+  ProductID const id3{4};
+}
+
+BOOST_AUTO_TEST_SUITE(resolve_t)
+
+BOOST_AUTO_TEST_CASE(same_as_get)
+{
+  FloatsGetter const g1{{0.f, 1.f, 2.f, 3.f}};
+  FloatsGetter const g2{{10.f, 11.f, 12.f}};
+  float const resolved{42.f};
+
+  // Interleaved products, a null Ptr and an already-resolved Ptr.
+  std::vector<Ptr<float>> const ptrs{{id1, 3, &g1},
+                                     {id1, 0, &g1},
+                                     {id2, 2, &g2},
+                                     {},
+                                     {id1, 1, &g1},
+                                     {id3, &resolved, 7},
+                                     {id2, 0, &g2},
+                                     {id1, 3, &g1}};
+  std::vector<float const*> items{nullptr};
+  resolve(ptrs, items);
+  BOOST_TEST(g1.calls() == 1u);
+  BOOST_TEST(g2.calls() == 1u);
+
+  BOOST_TEST_REQUIRE(items.size() == ptrs.size());
+  std::vector<float> const expected{3.f, 0.f, 12.f, 0.f, 1.f, 42.f, 10.f, 3.f};
+  for (std::size_t i{}; i != ptrs.size(); ++i) {
+    if (ptrs[i].isNull()) {
+      BOOST_TEST(items[i] == nullptr);
+      continue;
+    }
+    BOOST_TEST(ptrs[i].refCore().productPtr() == items[i]);
+    BOOST_TEST(items[i] == ptrs[i].get());
+    BOOST_TEST(*items[i] == expected[i]);
+  }
+  // All resolved already.
+  BOOST_TEST(g1.calls() == 1u);
+
+  std::vector<float const*> part;
+  resolve(std::span{ptrs}.subspan(2, 3), part);
+  BOOST_TEST((part == std::vector<float const*>{items[2], nullptr, items[4]}));
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+  std::vector<Ptr<float>> const ptrs;
+  std::vector<float const*> items{nullptr};
+  resolve(ptrs, items);
+  BOOST_TEST(items.empty());
+}
+
+BOOST_AUTO_TEST_CASE(missing_product)
+{
+  FloatsGetter const g1{{0.f}};
+  NoProductGetter const missing;
+  std::vector<Ptr<float>> const ptrs{{id1, 0, &g1}, {id2, 0, &missing}};
+  std::vector<float const*> items;
+  BOOST_CHECK_EXCEPTION(
+    resolve(ptrs, items), art::Exception, [](art::Exception const& e) {
+      return e.categoryCode() == errors::ProductNotFound;
+    });
+  std::vector<Ptr<float>> const noGetter{{id1, 0, nullptr}};
+  BOOST_CHECK_THROW(resolve(noGetter, items), art::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,226 @@
+#define BOOST_TEST_MODULE (CompactFileIndex_t)
+#include "boost/test/unit_test.hpp"
+#include "canvas/Persistency/Provenance/CompactFileIndex.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using art::CompactFileIndex;
+using art::EventID;
+using art::FileIndex;
+using art::RunID;
+using art::SubRunID;
+
+namespace {
+  FileIndex
+  makeFileIndex()
+  {
+    FileIndex result;
+    for (unsigned r = 2; r != 8; r += 2) {
+      result.addEntry(EventID::invalidEvent(RunID(r)), r);
+      for (unsigned sr = 0; sr != 6; sr += 2) {
+        result.addEntry(EventID::invalidEvent(SubRunID(r, sr)), r + sr);
+        for (unsigned e = 2; e != 12; e += 2) {
+          result.addEntry(EventID(r, sr, 5 * sr + e), 100 * r + 10 * sr + e);
+        }
+      }
+    }
+    // Duplicates, and a second run record.
+    result.addEntry(EventID(4, 2, 12), 3);
+    result.addEntry(EventID::invalidEvent(RunID(4)), 1);
+    result.sortBy_Run_SubRun_Event();
+    return result;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(CompactFileIndex_t)
+
+BOOST_AUTO_TEST_CASE(constructAndIterate)
+{
+  auto const fileIndex = makeFileIndex();
+  CompactFileIndex const compact{fileIndex};
+  BOOST_TEST(compact.size() == fileIndex.size());
+  BOOST_TEST(!compact.empty());
+  BOOST_TEST(compact.data_size() < fileIndex.size() * sizeof(FileIndex::Element));
+
+  auto it = compact.cbegin();
+  for (auto const& e : fileIndex) {
+    BOOST_TEST((*it).eventID == e.eventID);
+    BOOST_TEST((*it).entry == e.entry);
+    BOOST_TEST(compact.getEntryType(it.position()) == e.getEntryType());
+    ++it;
+  }
+  BOOST_TEST((it == compact.cend()));
+  BOOST_TEST((compact.toFileIndex() == fileIndex));
+
+  FileIndex empty;
+  CompactFileIndex const compactEmpty{empty};
+  BOOST_TEST(compactEmpty.empty());
+  BOOST_TEST(!compactEmpty.contains(EventID(1, 0, 1), true));
+}
+
+BOOST_AUTO_TEST_CASE(iteratorMoves)
+{
+  auto const fileIndex = makeFileIndex();
+  CompactFileIndex const compact{fileIndex};
+  auto const n = static_cast<std::ptrdiff_t>(compact.size());
+  auto const same = [](FileIndex::Element const& a,
+                       FileIndex::Element const& b) {
+    return a.eventID == b.eventID && a.entry == b.entry;
+  };
+
+  // Stepping backwards from the end.
+  auto it = compact.cend();
+  for (auto i = n; i != 0; --i) {
+    --it;
+    BOOST_TEST(same(*it, compact[i - 1]));
+  }
+  BOOST_TEST((it == compact.cbegin()));
+
+  // Jumps, followed by steps in both directions.
+  for (std::ptrdiff_t i = 0; i != n; ++i) {
+    auto jumped = compact.cbegin() + i;
+    BOOST_TEST(same(*jumped, compact[i]));
+    BOOST_TEST(same(compact.cbegin()[i], compact[i]));
+    if (i + 1 != n) {
+      BOOST_TEST(same(*++jumped, compact[i + 1]));
+      --jumped;
+    }
+    if (i != 0) {
+      BOOST_TEST(same(*--jumped, compact[i - 1]));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(searchMatchesFileIndex)
+{
+  auto const fileIndex = makeFileIndex();
+  CompactFileIndex const compact{fileIndex};
+  auto const pos = [](auto const& index, auto const& it) {
+    return it - index.cbegin();
+  };
+  for (unsigned r = 1; r != 9; ++r) {
+    BOOST_TEST(pos(compact, compact.findPosition(RunID(r), true)) ==
+               pos(fileIndex, fileIndex.findPosition(RunID(r), true)));
+    BOOST_TEST(pos(compact, compact.findPosition(RunID(r), false)) ==
+               pos(fileIndex, fileIndex.findPosition(RunID(r), false)));
+    for (unsigned sr = 0; sr != 7; ++sr) {
+      SubRunID const srID(r, sr);
+      BOOST_TEST(pos(compact, compact.findPosition(srID, true)) ==
+                 pos(fileIndex, fileIndex.findPosition(srID, true)));
+      BOOST_TEST(pos(compact, compact.findPosition(srID, false)) ==
+                 pos(fileIndex, fileIndex.findPosition(srID, false)));
+      BOOST_TEST(pos(compact, compact.findSubRunOrRunPosition(srID)) ==
+                 pos(fileIndex, fileIndex.findSubRunOrRunPosition(srID)));
+      for (unsigned e = 1; e != 40; ++e) {
+        EventID const id(r, sr, e);
+        BOOST_TEST(pos(compact, compact.findPosition(id, true)) ==
+                   pos(fileIndex, fileIndex.findPosition(id, true)));
+        BOOST_TEST(pos(compact, compact.findPosition(id, false)) ==
+                   pos(fileIndex, fileIndex.findPosition(id, false)));
+      }
+    }
+  }
+
+  // Unspecified subrun: the lowest matching subrun is found.
+  auto it = compact.findPosition(
+    EventID(SubRunID::invalidSubRun(RunID(4)), 12), true);
+  BOOST_TEST((*it).eventID == EventID(4, 2, 12));
+  BOOST_TEST(!compact.contains(
+    EventID(SubRunID::invalidSubRun(RunID(4)), 13), true));
+  BOOST_TEST(!compact.contains(
+    EventID(SubRunID::invalidSubRun(RunID(5)), 12), true));
+}
+
+BOOST_AUTO_TEST_CASE(viewOfBlob)
+{
+  auto const fileIndex = makeFileIndex();
+  std::vector<std::uint64_t> blob;
+  {
+    CompactFileIndex const compact{fileIndex};
+    blob.resize(compact.data_size() / sizeof(std::uint64_t));
+    std::memcpy(blob.data(), compact.data(), compact.data_size());
+  }
+  CompactFileIndex const view{blob.data(), blob.size() * sizeof(std::uint64_t)};
+  BOOST_TEST(view.data() == blob.data());
+  BOOST_TEST((view.toFileIndex() == fileIndex));
+  BOOST_TEST(view.contains(EventID(6, 4, 22), true));
+
+  auto const copy = view;
+  BOOST_TEST(copy.data() == blob.data());
+
+  BOOST_CHECK_THROW((CompactFileIndex{blob.data(), 8}), art::Exception);
+  blob[0] = 0;
+  BOOST_CHECK_THROW((CompactFileIndex{blob.data(),
+                                      blob.size() * sizeof(std::uint64_t)}),
+                    art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(fileIndexOverBlob)
+{
+  auto const fileIndex = makeFileIndex();
+  std::vector<std::uint64_t> blob;
+  {
+    CompactFileIndex const compact{fileIndex};
+    blob.resize(compact.data_size() / sizeof(std::uint64_t));
+    std::memcpy(blob.data(), compact.data(), compact.data_size());
+  }
+  FileIndex backed{
+    CompactFileIndex{blob.data(), blob.size() * sizeof(std::uint64_t)}};
+
+  // Answered from the blob.
+  BOOST_TEST(backed.size() == fileIndex.size());
+  BOOST_TEST(!backed.empty());
+  BOOST_TEST(backed.allEventsInEntryOrder() ==
+             fileIndex.allEventsInEntryOrder());
+  BOOST_TEST(backed.eventsUniqueAndOrdered() ==
+             fileIndex.eventsUniqueAndOrdered());
+  for (unsigned r = 1; r != 10; ++r) {
+    BOOST_TEST(backed.contains(RunID(r), true) ==
+               fileIndex.contains(RunID(r), true));
+    for (unsigned sr = 0; sr != 8; ++sr) {
+      BOOST_TEST(backed.contains(SubRunID(r, sr), true) ==
+                 fileIndex.contains(SubRunID(r, sr), true));
+      for (unsigned e = 1; e != 40; ++e) {
+        for (bool const exact : {true, false}) {
+          BOOST_TEST(backed.contains(EventID(r, sr, e), exact) ==
+                     fileIndex.contains(EventID(r, sr, e), exact));
+        }
+      }
+    }
+    BOOST_TEST(
+      backed.contains(EventID(SubRunID::invalidSubRun(RunID(r)), 12), true) ==
+      fileIndex.contains(EventID(SubRunID::invalidSubRun(RunID(r)), 12), true));
+  }
+
+  // Copies share the blob; each materializes its own entries.
+  auto const copy = backed;
+  BOOST_TEST((copy == fileIndex));
+
+  // Iteration and searches materialize the entries, after which the
+  // blob is no longer needed.
+  auto const it = backed.findPosition(EventID(4, 2, 14), true);
+  BOOST_TEST(std::distance(backed.cbegin(), it) ==
+             std::distance(fileIndex.cbegin(),
+                           fileIndex.findPosition(EventID(4, 2, 14), true)));
+  blob.assign(blob.size(), 0);
+  BOOST_TEST((backed == fileIndex));
+  BOOST_TEST(backed.contains(EventID(6, 4, 22), true));
+  backed.addEntry(EventID(8, 0, 1), 7);
+  backed.sortBy_Run_SubRun_Event();
+  BOOST_TEST(backed.size() == fileIndex.size() + 1);
+
+  BOOST_TEST(FileIndex{CompactFileIndex{FileIndex{}}}.empty());
+}
+
+BOOST_AUTO_TEST_CASE(requiresSortedIndex)
+{
+  FileIndex fileIndex;
+  fileIndex.addEntry(EventID(2, 0, 1), 0);
+  fileIndex.addEntry(EventID(1, 0, 1), 1);
+  BOOST_CHECK_THROW(CompactFileIndex{fileIndex}, art::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+// vim: set sw=2 expandtab :
+
+// Compare exact event lookups in the FileIndex using the default
+// binary search against the optional hash-based event index.
+//
+// Usage: FileIndex_bench [max-entries]  (default 10^7)
+
+#include "canvas/Persistency/Provenance/FileIndex.h"
+#include "canvas/Persistency/Provenance/RunID.h"
+#include "canvas/Persistency/Provenance/SubRunID.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace art;
+using namespace std;
+
+namespace {
+
+  constexpr unsigned events_per_subrun{1000};
+  constexpr unsigned subruns_per_run{100};
+
+  FileIndex
+  make_index(unsigned const n_events)
+  {
+    FileIndex result;
+    FileIndex::EntryNumber_t entry{};
+    for (unsigned i{}; i != n_events; ++i) {
+      auto const r = 1 + i / (events_per_subrun * subruns_per_run);
+      auto const sr = (i / events_per_subrun) % subruns_per_run;
+      auto const e = 1 + i % events_per_subrun;
+      if (i % (events_per_subrun * subruns_per_run) == 0) {
+        result.addEntry(EventID::invalidEvent(RunID(r)), r - 1);
+      }
+      if (i % events_per_subrun == 0) {
+        result.addEntry(EventID::invalidEvent(SubRunID(r, sr)), r - 1);
+      }
+      result.addEntry(EventID(r, sr, e), entry++);
+    }
+    result.sortBy_Run_SubRun_Event();
+    return result;
+  }
+
+  vector<EventID>
+  make_queries(FileIndex const& index, unsigned const n)
+  {
+    vector<EventID> all;
+    for (auto const& e : index) {
+      if (e.getEntryType() == FileIndex::kEvent) {
+        all.push_back(e.eventID);
+      }
+    }
+    mt19937 gen{42};
+    uniform_int_distribution<size_t> dist{0, all.size() - 1};
+    vector<EventID> result;
+    result.reserve(n);
+    for (unsigned i{}; i != n; ++i) {
+      result.push_back(all[dist(gen)]);
+    }
+    return result;
+  }
+
+  double
+  time_lookups(FileIndex const& index, vector<EventID> const& queries)
+  {
+    size_t found{};
+    auto const start = chrono::steady_clock::now();
+    for (auto const& id : queries) {
+      found += index.contains(id, true);
+    }
+    chrono::duration<double, nano> const elapsed =
+      chrono::steady_clock::now() - start;
+    if (found != queries.size()) {
+      cerr << "Lookup failure: found " << found << " of " << queries.size()
+           << " events.\n";
+      exit(1);
+    }
+    return elapsed.count() / queries.size();
+  }
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const max_entries = argc > 1 ? atoi(argv[1]) : 10'000'000;
+  unsigned constexpr n_queries{1'000'000};
+
+  cout << setw(12) << "entries" << setw(16) << "binary (ns)" << setw(16)
+       << "hashed (ns)" << setw(16) << "build (ms)"
+       << "\n";
+  for (unsigned n = 1000; n <= max_entries; n *= 10) {
+    auto index = make_index(n);
+    auto const queries = make_queries(index, n_queries);
+    auto const binary = time_lookups(index, queries);
+
+    auto const start = chrono::steady_clock::now();
+    index.enableEventIndex();
+    chrono::duration<double, milli> const build =
+      chrono::steady_clock::now() - start;
+    auto const hashed = time_lookups(index, queries);
+
+    cout << setw(12) << n << setw(16) << binary << setw(16) << hashed
+         << setw(16) << build.count() << "\n";
+  }
+}
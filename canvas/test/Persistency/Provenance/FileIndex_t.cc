@@ -2,6 +2,11 @@
 #include "boost/test/unit_test.hpp"
 #include "canvas/Persistency/Provenance/FileIndex.h"
 
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
 namespace art {
   std::ostream&
   boost_test_print_type(std::ostream& os, FileIndex::iterator it)
@@ -444,4 +449,163 @@ BOOST_AUTO_TEST_CASE(eventsUniqueAndOrderedTest)
   BOOST_TEST(fileIndex8.eventsUniqueAndOrdered());
 }
 
+BOOST_AUTO_TEST_CASE(eventIndexSearchTest)
+{
+  // The hash-indexed lookup must agree with the binary search,
+  // including for duplicated events and unspecified subruns.
+  art::FileIndex fileIndex;
+  for (unsigned r = 1; r != 4; ++r) {
+    fileIndex.addEntry(EventID::invalidEvent(RunID(r)), r);
+    for (unsigned sr = 0; sr != 4; ++sr) {
+      fileIndex.addEntry(EventID::invalidEvent(SubRunID(r, sr)), r);
+      for (unsigned e = 1; e != 6; ++e) {
+        fileIndex.addEntry(EventID(r, sr, 10 * sr + e), e);
+      }
+    }
+  }
+  fileIndex.addEntry(EventID(2, 1, 12), 7);
+  fileIndex.addEntry(EventID(3, 2, 11), 7);
+  fileIndex.sortBy_Run_SubRun_Event();
+
+  art::FileIndex indexed{fileIndex};
+  indexed.enableEventIndex();
+  BOOST_TEST(indexed.eventIndexEnabled());
+  BOOST_TEST(!fileIndex.eventIndexEnabled());
+
+  auto const invalidSubRun = [](unsigned const r) {
+    return SubRunID::invalidSubRun(RunID(r));
+  };
+  for (unsigned r = 1; r != 5; ++r) {
+    for (unsigned e = 1; e != 40; ++e) {
+      for (unsigned sr = 0; sr != 5; ++sr) {
+        EventID const id(r, sr, e);
+        BOOST_TEST((indexed.findPosition(id, true) - indexed.cbegin()) ==
+                   (fileIndex.findPosition(id, true) - fileIndex.cbegin()));
+        BOOST_TEST(indexed.contains(id, true) == fileIndex.contains(id, true));
+      }
+      EventID const id(invalidSubRun(r), e);
+      BOOST_TEST((indexed.findPosition(id, true) - indexed.cbegin()) ==
+                 (fileIndex.findPosition(id, true) - fileIndex.cbegin()));
+    }
+  }
+
+  // Adding an entry discards the index.
+  indexed.addEntry(EventID(4, 0, 1), 1);
+  indexed.sortBy_Run_SubRun_Event();
+  BOOST_TEST(indexed.contains(EventID(4, 0, 1), true));
+  BOOST_TEST(indexed.contains(EventID(invalidSubRun(4), 1), true));
+
+  // Entries changed other than by addEntry are found by the binary
+  // search until the index is rebuilt.
+  std::prev(indexed.end())->eventID = EventID(4, 0, 5);
+  BOOST_TEST(!indexed.contains(EventID(4, 0, 1), true));
+  BOOST_TEST(indexed.contains(EventID(4, 0, 5), true));
+  indexed.addEntryOnLoad(EventID(4, 0, 6), 2);
+  BOOST_TEST(indexed.contains(EventID(4, 0, 6), true));
+  BOOST_TEST(indexed.contains(EventID(invalidSubRun(4), 6), true));
+  indexed.enableEventIndex();
+  BOOST_TEST(indexed.contains(EventID(4, 0, 6), true));
+  BOOST_TEST(!indexed.contains(EventID(4, 0, 2), true));
+}
+
+BOOST_AUTO_TEST_CASE(incrementalAndParallelSortTest)
+{
+  // Enough entries to exercise the parallel sort, with duplicated
+  // IDs to check stability.
+  std::vector<std::pair<EventID, art::FileIndex::EntryNumber_t>> ids;
+  unsigned seed{1};
+  for (unsigned i = 0; i != 300000; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    auto const r = 1 + (seed >> 8) % 7;
+    auto const sr = (seed >> 12) % 11;
+    auto const e = 1 + (seed >> 16) % 3001;
+    ids.emplace_back(i % 97 == 0 ? EventID::invalidEvent(SubRunID(r, sr)) :
+                                   EventID(r, sr, e),
+                     i);
+  }
+
+  auto const serialSort = [](auto const& entries, bool const byEntry) {
+    std::vector<art::FileIndex::Element> result;
+    for (auto const& [id, entry] : entries) {
+      result.emplace_back(id, entry);
+    }
+    if (byEntry) {
+      std::stable_sort(
+        result.begin(), result.end(), art::Compare_Run_SubRun_EventEntry{});
+    } else {
+      std::stable_sort(result.begin(), result.end());
+    }
+    return result;
+  };
+  auto const equal = [](art::FileIndex const& fileIndex,
+                        std::vector<art::FileIndex::Element> const& ref) {
+    return fileIndex.size() == ref.size() &&
+           std::equal(ref.begin(),
+                      ref.end(),
+                      fileIndex.begin(),
+                      [](auto const& a, auto const& b) {
+                        return a.eventID == b.eventID && a.entry == b.entry;
+                      });
+  };
+
+  for (bool const byEntry : {false, true}) {
+    auto const sort = [byEntry](art::FileIndex& fileIndex) {
+      if (byEntry) {
+        fileIndex.sortBy_Run_SubRun_EventEntry();
+      } else {
+        fileIndex.sortBy_Run_SubRun_Event();
+      }
+    };
+
+    // Full sort of a large index.
+    art::FileIndex fileIndex;
+    for (auto const& [id, entry] : ids) {
+      fileIndex.addEntry(id, entry);
+    }
+    sort(fileIndex);
+    BOOST_TEST(equal(fileIndex, serialSort(ids, byEntry)));
+
+    // Incremental sort after appending a few entries.
+    auto more = ids;
+    for (unsigned i = 0; i != 25; ++i) {
+      EventID const id(1 + i % 7, i % 11, 1 + 97 * i);
+      fileIndex.addEntry(id, 1000000 + i);
+      more.emplace_back(id, 1000000 + i);
+    }
+    sort(fileIndex);
+    auto const expected = serialSort(more, byEntry);
+    BOOST_TEST(equal(fileIndex, expected));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(mixedAdditionsSortTest)
+{
+  auto const sorted = [](art::FileIndex const& fileIndex) {
+    return std::is_sorted(fileIndex.cbegin(), fileIndex.cend());
+  };
+  auto const makeSorted = [] {
+    art::FileIndex result;
+    for (unsigned e = 1; e != 10; ++e) {
+      result.addEntry(EventID(2, 1, e), e);
+    }
+    result.sortBy_Run_SubRun_Event();
+    result.addEntry(EventID(1, 1, 1), 10);
+    return result;
+  };
+
+  // An entry added by addEntryOnLoad() after addEntry().
+  auto fileIndex = makeSorted();
+  fileIndex.addEntryOnLoad(EventID(3, 1, 1), 11);
+  fileIndex.sortBy_Run_SubRun_Event();
+  BOOST_TEST(sorted(fileIndex));
+  BOOST_TEST(fileIndex.cbegin()->eventID == EventID(1, 1, 1));
+
+  // An entry changed through the non-const iterators after addEntry().
+  fileIndex = makeSorted();
+  fileIndex.begin()->eventID = EventID(4, 1, 1);
+  fileIndex.sortBy_Run_SubRun_Event();
+  BOOST_TEST(sorted(fileIndex));
+  BOOST_TEST(std::prev(fileIndex.cend())->eventID == EventID(4, 1, 1));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,129 @@
+#define BOOST_TEST_MODULE (Hash_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Provenance/Hash.h"
+#include "cetlib/MD5Digest.h"
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+
+using TestHash = art::Hash<99>;
+
+static_assert(std::is_trivially_copyable_v<art::Hash<1>>);
+static_assert(sizeof(TestHash) == 16);
+
+namespace {
+  cet::MD5Result
+  digest(std::string const& s)
+  {
+    return cet::MD5Digest{s}.digest();
+  }
+
+  // Stands in for the custom streamer, which reads the persistent
+  // std::string of class version 10 into an existing object.
+  TestHash
+  read(std::string const& onfile)
+  {
+    TestHash result;
+    result = TestHash{onfile};
+    return result;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(Hash_t)
+
+BOOST_AUTO_TEST_CASE(construction)
+{
+  TestHash const invalid;
+  BOOST_TEST(!invalid.isValid());
+  BOOST_TEST(invalid == TestHash{std::string{}});
+  BOOST_TEST(invalid.compactForm() == art::detail::InvalidHash());
+
+  auto const md5 = digest("a string");
+  TestHash const fromCompact{md5.compactForm()};
+  TestHash const fromHex{md5.toString()};
+  BOOST_TEST(fromCompact.isValid());
+  BOOST_TEST(fromCompact == fromHex);
+  BOOST_TEST(fromCompact.compactForm() == md5.compactForm());
+
+  std::ostringstream os;
+  os << fromHex;
+  BOOST_TEST(os.str() == md5.toString());
+
+  BOOST_CHECK_THROW(TestHash{"bad"}, art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(ordering)
+{
+  // Ordering must agree with that of the compact string forms.
+  for (auto const& [a, b] : {std::pair{"one", "two"},
+                             std::pair{"three", "four"},
+                             std::pair{"five", "five"}}) {
+    auto const sa = digest(a).compactForm();
+    auto const sb = digest(b).compactForm();
+    TestHash const ha{sa};
+    TestHash const hb{sb};
+    BOOST_TEST((ha < hb) == (sa < sb));
+    BOOST_TEST((ha > hb) == (sa > sb));
+    BOOST_TEST((ha == hb) == (sa == sb));
+    BOOST_TEST((ha != hb) == (sa != sb));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(readVersion10)
+{
+  auto const md5 = digest("a string");
+  TestHash const expected{md5.compactForm()};
+  for (auto const& onfile : {md5.compactForm(), md5.toString()}) {
+    auto const h = read(onfile);
+    BOOST_TEST(h.isValid());
+    BOOST_TEST(h.isCompactForm());
+    BOOST_TEST(h == expected);
+    BOOST_TEST(!(h < expected));
+    BOOST_TEST(!(h > expected));
+    BOOST_TEST(h.compactForm() == md5.compactForm());
+    BOOST_TEST((h.bytes() == expected.bytes()));
+    BOOST_TEST(std::hash<TestHash>{}(h) == std::hash<TestHash>{}(expected));
+    std::ostringstream os;
+    os << h;
+    BOOST_TEST(os.str() == md5.toString());
+  }
+
+  auto const other = read(digest("another string").toString());
+  BOOST_TEST((other < expected) ==
+             (digest("another string").compactForm() < md5.compactForm()));
+  BOOST_TEST(!read(std::string{}).isValid());
+  BOOST_TEST(read(std::string{}) == TestHash{});
+}
+
+BOOST_AUTO_TEST_CASE(writeVersion10)
+{
+  // The streamer writes the compact form.
+  auto const md5 = digest("a string");
+  TestHash const h{md5.toString()};
+  BOOST_TEST(h.compactForm() == md5.compactForm());
+  BOOST_TEST(read(h.compactForm()) == h);
+  BOOST_TEST(TestHash{}.compactForm() == art::detail::InvalidHash());
+}
+
+BOOST_AUTO_TEST_CASE(constexprComparisons)
+{
+  constexpr TestHash a{TestHash::value_type{}};
+  constexpr TestHash b{TestHash::value_type{std::byte{1}}};
+  static_assert(a < b && b > a && a != b && !(a == b));
+  BOOST_TEST((TestHash{a.bytes()} == a));
+}
+
+BOOST_AUTO_TEST_CASE(hashing)
+{
+  std::unordered_set<TestHash> ids;
+  for (auto const s : {"one", "two", "three", "one"}) {
+    ids.insert(TestHash{digest(s).compactForm()});
+  }
+  BOOST_TEST(ids.size() == 3u);
+  BOOST_TEST(ids.count(TestHash{digest("two").toString()}) == 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
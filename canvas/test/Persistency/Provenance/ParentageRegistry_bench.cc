@@ -0,0 +1,103 @@
+// vim: set sw=2 expandtab :
+
+// Measure the lookup throughput of the ParentageRegistry with 1 to 64
+// concurrent reading threads, compared with that of a mutex-guarded
+// std::map (the registry's previous implementation).
+//
+// Usage: ParentageRegistry_bench [lookups-per-thread]  (default 10^6)
+
+#include "canvas/Persistency/Provenance/Parentage.h"
+#include "canvas/Persistency/Provenance/ParentageRegistry.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace art;
+using namespace std;
+
+namespace {
+
+  constexpr unsigned n_parentages{10000};
+
+  map<ParentageID, Parentage> locked_map;
+  mutex locked_map_mutex;
+
+  bool
+  locked_get(ParentageID const& id, Parentage& p)
+  {
+    lock_guard sentry{locked_map_mutex};
+    auto it = locked_map.find(id);
+    if (it == locked_map.cend()) {
+      return false;
+    }
+    p = it->second;
+    return true;
+  }
+
+  template <typename Get>
+  double
+  run(unsigned const n_threads,
+      unsigned const n_lookups,
+      vector<ParentageID> const& ids,
+      Get get)
+  {
+    vector<thread> threads;
+    auto const start = chrono::steady_clock::now();
+    for (unsigned t{}; t != n_threads; ++t) {
+      threads.emplace_back([&ids, n_lookups, t, get] {
+        Parentage p;
+        auto i = t * 7919u;
+        for (unsigned n{}; n != n_lookups; ++n) {
+          i = (i + 104729u) % ids.size();
+          if (!get(ids[i], p)) {
+            cerr << "Lookup failure.\n";
+            exit(1);
+          }
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+    chrono::duration<double> const elapsed =
+      chrono::steady_clock::now() - start;
+    return n_threads * n_lookups / elapsed.count() / 1e6;
+  }
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const n_lookups = argc > 1 ? atoi(argv[1]) : 1'000'000;
+
+  vector<ParentageID> ids;
+  for (unsigned i{}; i != n_parentages; ++i) {
+    Parentage const p{{ProductID{"product" + to_string(i)},
+                       ProductID{"other" + to_string(i)}}};
+    ids.push_back(p.id());
+    ParentageRegistry::emplace(ids.back(), p);
+    locked_map.emplace(ids.back(), p);
+  }
+
+  cout << setw(10) << "threads" << setw(20) << "registry (Mops/s)"
+       << setw(20) << "locked map (Mops/s)"
+       << "\n";
+  for (unsigned n = 1; n <= 64; n *= 2) {
+    auto const registry =
+      run(n, n_lookups, ids, [](ParentageID const& id, Parentage& p) {
+        return ParentageRegistry::get(id, p);
+      });
+    auto const locked = run(n, n_lookups, ids, locked_get);
+    cout << setw(10) << n << setw(20) << registry << setw(20) << locked
+         << "\n";
+  }
+}
@@ -7,6 +7,7 @@
 #include "cetlib/container_algorithms.h"
 #include "hep_concurrency/simultaneous_function_spawner.h"
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -73,4 +74,72 @@ BOOST_AUTO_TEST_CASE(concurrent_insertion_reading)
   }
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_growth_reading)
+{
+  // Enough entries to force the lookup table to be regrown several
+  // times while other threads are reading.
+  std::vector<Parentage> parentages;
+  for (unsigned i = 0; i != 5000; ++i) {
+    parentages.emplace_back(
+      std::vector<ProductID>{ProductID{"growth" + std::to_string(i)}});
+  }
+  std::vector<ParentageID> ids;
+  cet::transform_all(parentages, std::back_inserter(ids), [](auto const& p) {
+    return p.id();
+  });
+
+  std::atomic<unsigned> failures{};
+  std::vector<std::function<void()>> tasks;
+  tasks.push_back([&parentages, &ids] {
+    for (std::size_t i = 0; i != parentages.size(); ++i) {
+      ParentageRegistry::emplace(ids[i], parentages[i]);
+    }
+  });
+  for (unsigned t = 0; t != 4; ++t) {
+    tasks.push_back([&parentages, &ids, &failures] {
+      // An entry, once found, must stay found.
+      std::size_t found{};
+      while (found != parentages.size()) {
+        Parentage retrieved;
+        if (ParentageRegistry::get(ids[found], retrieved)) {
+          if (retrieved != parentages[found]) {
+            ++failures;
+          }
+          ++found;
+          for (std::size_t j = 0; j < found; j += 97) {
+            if (!ParentageRegistry::get(ids[j], retrieved)) {
+              ++failures;
+            }
+          }
+        }
+      }
+    });
+  }
+  hep::concurrency::simultaneous_function_spawner sfs{tasks};
+  BOOST_TEST(failures == 0u);
+  BOOST_TEST(ParentageRegistry::get().size() >= parentages.size());
+}
+
+BOOST_AUTO_TEST_CASE(batch_insertion)
+{
+  std::vector<Parentage> parentages;
+  for (unsigned i = 0; i != 100; ++i) {
+    // Every parent list appears twice.
+    parentages.emplace_back(
+      std::vector<ProductID>{ProductID{"batch" + std::to_string(i % 50)},
+                             ProductID{"batch"}});
+  }
+  auto const ids = ParentageRegistry::put_many(parentages);
+  BOOST_TEST_REQUIRE(ids.size() == parentages.size());
+  for (std::size_t i = 0; i != parentages.size(); ++i) {
+    BOOST_TEST(ids[i] == parentages[i].id());
+    BOOST_TEST(ids[i] == ids[i % 50]);
+    Parentage retrieved;
+    BOOST_TEST(ParentageRegistry::get(ids[i], retrieved));
+    BOOST_TEST(retrieved == parentages[i]);
+    BOOST_TEST(retrieved.id() == ids[i]);
+  }
+  BOOST_TEST(ParentageRegistry::put_many({}).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,98 @@
+// vim: set sw=2 expandtab :
+
+// Measure the time to look up the product IDs for a friendly class
+// name and process name, in a table of several thousand products,
+// using the flat, symbol-keyed ProductLookup and using the nested,
+// name-keyed ProductLookup_t from which it is built.
+//
+// Usage: ProductLookup_bench [n-products] [n-lookups]
+//        (defaults 2500 and 10^7)
+
+#include "canvas/Persistency/Provenance/ProductLookup.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace art;
+using namespace std;
+
+namespace {
+
+  template <typename F>
+  double
+  time_ns_per_lookup(unsigned const n_lookups, F f)
+  {
+    auto const start = chrono::steady_clock::now();
+    f();
+    chrono::duration<double, nano> const elapsed =
+      chrono::steady_clock::now() - start;
+    return elapsed.count() / n_lookups;
+  }
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const n_products = argc > 1 ? atoi(argv[1]) : 2500;
+  unsigned const n_lookups = argc > 2 ? atoi(argv[2]) : 10'000'000;
+  vector<string> const processes{"DAQ", "RECO", "ANALYSIS"};
+
+  // Products of n_products / 2 types, each type produced in one or two
+  // processes.
+  ProductLookup_t byName;
+  vector<pair<string, string>> queries;
+  for (unsigned i{}; i != n_products; ++i) {
+    auto const fcn = "artdata::ProductType" + to_string(i / 2) + "s";
+    auto const& process = processes[i % processes.size()];
+    byName[fcn][process].emplace_back(i);
+    queries.emplace_back(fcn, process);
+  }
+  ProductLookup const lookup{byName};
+
+  vector<pair<Symbol, Symbol>> symbolQueries;
+  for (auto const& [fcn, process] : queries) {
+    symbolQueries.emplace_back(Symbol{fcn}, Symbol{process});
+  }
+
+  size_t found{};
+  auto const map_ns = time_ns_per_lookup(n_lookups, [&] {
+    for (unsigned n{}, i{}; n != n_lookups; ++n) {
+      i = (i + 7919) % queries.size();
+      auto const& [fcn, process] = queries[i];
+      auto it = byName.find(fcn);
+      if (it != byName.cend()) {
+        auto pit = it->second.find(process);
+        if (pit != it->second.cend()) {
+          found += pit->second.size();
+        }
+      }
+    }
+  });
+  auto const string_ns = time_ns_per_lookup(n_lookups, [&] {
+    for (unsigned n{}, i{}; n != n_lookups; ++n) {
+      i = (i + 7919) % queries.size();
+      auto const& [fcn, process] = queries[i];
+      found += lookup.find(fcn, process).size();
+    }
+  });
+  auto const symbol_ns = time_ns_per_lookup(n_lookups, [&] {
+    for (unsigned n{}, i{}; n != n_lookups; ++n) {
+      i = (i + 7919) % symbolQueries.size();
+      auto const [fcn, process] = symbolQueries[i];
+      found += lookup.find(fcn, process).size();
+    }
+  });
+
+  if (found != 3ull * n_lookups) {
+    cerr << "Lookup failure.\n";
+    return 1;
+  }
+  cout << "products: " << n_products << '\n'
+       << "nested std::map lookup:      " << map_ns << " ns\n"
+       << "ProductLookup, by string:    " << string_ns << " ns\n"
+       << "ProductLookup, by Symbol:    " << symbol_ns << " ns\n";
+}
@@ -0,0 +1,122 @@
+#define BOOST_TEST_MODULE (ProductLookup_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Provenance/ProductLookup.h"
+
+#include <cstddef>
+#include <vector>
+
+using namespace art;
+
+namespace {
+  std::vector<ProductID>
+  to_vector(std::span<ProductID const> const pids)
+  {
+    return {pids.begin(), pids.end()};
+  }
+
+  // The flat lookup holds the same product IDs as the nested one.
+  bool
+  same_as(ProductLookup const& lookup, ProductLookup_t const& byName)
+  {
+    for (auto const& [fcn, processes] : byName) {
+      for (auto const& [process, processPIDs] : processes) {
+        if (to_vector(lookup.find(fcn, process)) != processPIDs) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool
+  same_as(ViewLookup const& lookup, ViewLookup_t const& byName)
+  {
+    std::size_t n{};
+    for (auto const& [process, processPIDs] : byName) {
+      if (to_vector(lookup.find(process)) != processPIDs) {
+        return false;
+      }
+      n += processPIDs.size();
+    }
+    return lookup.all().size() == n;
+  }
+
+  std::vector<ProductID>
+  pids(std::initializer_list<ProductID::value_type> const values)
+  {
+    std::vector<ProductID> result;
+    for (auto const v : values) {
+      result.emplace_back(v);
+    }
+    return result;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(ProductLookupTest)
+
+BOOST_AUTO_TEST_CASE(products)
+{
+  ProductLookup_t const byName{
+    {"ints", {{"DAQ", pids({3, 1})}, {"RECO", pids({7})}}},
+    {"floats", {{"RECO", pids({9, 2})}}},
+    {"empty", {{"DAQ", {}}}}};
+  ProductLookup const lookup{byName};
+  BOOST_TEST(!lookup.empty());
+  BOOST_TEST(same_as(lookup, byName));
+
+  BOOST_TEST((to_vector(lookup.find("ints", "DAQ")) == pids({3, 1})));
+  BOOST_TEST((to_vector(lookup.find("ints", "RECO")) == pids({7})));
+  BOOST_TEST((to_vector(lookup.find("floats", "RECO")) == pids({9, 2})));
+  BOOST_TEST(lookup.find("floats", "DAQ").empty());
+  BOOST_TEST(lookup.find("empty", "DAQ").empty());
+  BOOST_TEST(lookup.find("ProductLookup_t_unknown", "DAQ").empty());
+  BOOST_TEST(lookup.find("ints", "ProductLookup_t_unknown").empty());
+
+  // All processes, in process-name order
+  BOOST_TEST((to_vector(lookup.find("ints")) == pids({3, 1, 7})));
+  BOOST_TEST((to_vector(lookup.find(Symbol{"floats"})) == pids({9, 2})));
+  BOOST_TEST(lookup.find("ProductLookup_t_unknown").empty());
+
+  BOOST_TEST((to_vector(lookup.find(Symbol{"ints"}, Symbol{"RECO"})) ==
+              pids({7})));
+  BOOST_TEST(lookup.find(Symbol{"ints"}, Symbol{}).empty());
+  BOOST_TEST(lookup.find(Symbol{}, Symbol{"RECO"}).empty());
+
+  ProductLookup const empty;
+  BOOST_TEST(empty.empty());
+  BOOST_TEST(empty.find("ints", "DAQ").empty());
+}
+
+BOOST_AUTO_TEST_CASE(views)
+{
+  ViewLookup_t const byName{{"DAQ", pids({4})}, {"RECO", pids({8, 5})}};
+  ViewLookup const lookup{byName};
+  BOOST_TEST(same_as(lookup, byName));
+  BOOST_TEST((to_vector(lookup.find("RECO")) == pids({8, 5})));
+  BOOST_TEST((to_vector(lookup.find(Symbol{"DAQ"})) == pids({4})));
+  BOOST_TEST(lookup.find("ProductLookup_t_unknown").empty());
+  BOOST_TEST(lookup.find(Symbol{}).empty());
+  BOOST_TEST((to_vector(lookup.all()) == pids({4, 8, 5})));
+}
+
+BOOST_AUTO_TEST_CASE(many_entries)
+{
+  ProductLookup_t byName;
+  for (ProductID::value_type i = 0; i != 3000; ++i) {
+    auto& processes = byName["type" + std::to_string(i)];
+    processes["p" + std::to_string(i % 3)].emplace_back(i);
+    processes["p3"].emplace_back(i + 10000);
+  }
+  ProductLookup const lookup{byName};
+  BOOST_TEST(same_as(lookup, byName));
+  for (ProductID::value_type i = 0; i != 3000; ++i) {
+    auto const type = "type" + std::to_string(i);
+    BOOST_TEST((to_vector(lookup.find(type, "p" + std::to_string(i % 3))) ==
+                pids({i})));
+    BOOST_TEST(lookup.find(type, "p" + std::to_string((i + 1) % 3)).empty());
+    BOOST_TEST((to_vector(lookup.find(type)) == pids({i, i + 10000})));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
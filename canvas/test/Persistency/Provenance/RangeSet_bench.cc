@@ -0,0 +1,131 @@
+// vim: set sw=2 expandtab :
+
+// Measure RangeSet::contains, merge, and disjoint_ranges for range
+// sets of 10^4 to 10^6 fragmented ranges, as produced by
+// concatenating many sub-files.  The indexed operations are compared
+// with the linear scan and merge-then-collapse approach used for
+// unindexed range sets.
+//
+// Usage: RangeSet_bench [max-ranges]  (default 10^6)
+
+#include "canvas/Persistency/Provenance/EventRange.h"
+#include "canvas/Persistency/Provenance/RangeSet.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using namespace art;
+using namespace std;
+
+namespace {
+
+  constexpr RunNumber_t run{1};
+  constexpr unsigned ranges_per_subrun{1000};
+  constexpr unsigned n_lookups{100'000};
+
+  // Ranges [4i+offset, 4i+offset+2) so that the sets made with
+  // offsets 0 and 2 interleave without overlapping.
+  RangeSet
+  make_range_set(unsigned const n_ranges, unsigned const offset)
+  {
+    RangeSet result{run};
+    for (unsigned i{}; i != n_ranges; ++i) {
+      auto const sr = i / ranges_per_subrun;
+      auto const b = 4 * (i % ranges_per_subrun) + offset;
+      result.emplace_range(sr, b, b + 2);
+    }
+    return result;
+  }
+
+  bool
+  linear_contains(RangeSet const& rs, SubRunNumber_t const s, EventNumber_t e)
+  {
+    for (auto const& range : rs) {
+      if (range.contains(s, e)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename F>
+  double
+  time_ms(F f)
+  {
+    auto const start = chrono::steady_clock::now();
+    f();
+    chrono::duration<double, milli> const elapsed =
+      chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const max_ranges = argc > 1 ? atoi(argv[1]) : 1'000'000;
+
+  cout << setw(10) << "ranges" << setw(18) << "contains (ms)"
+       << setw(18) << "linear (ms)" << setw(16) << "merge (ms)"
+       << setw(20) << "merge+sort (ms)" << setw(18) << "disjoint (ms)"
+       << "\n";
+  for (unsigned n = 10'000; n <= max_ranges; n *= 10) {
+    auto const evens = make_range_set(n, 0);
+    auto const odds = make_range_set(n, 2);
+
+    mt19937 gen{42};
+    uniform_int_distribution<unsigned> sr_dist{0, n / ranges_per_subrun};
+    uniform_int_distribution<unsigned> e_dist{0, 4 * ranges_per_subrun};
+    vector<pair<SubRunNumber_t, EventNumber_t>> queries;
+    for (unsigned i{}; i != n_lookups; ++i) {
+      queries.emplace_back(sr_dist(gen), e_dist(gen));
+    }
+
+    unsigned found{}, found_linear{};
+    auto const t_contains = time_ms([&] {
+      for (auto const& [s, e] : queries) {
+        found += evens.contains(run, s, e);
+      }
+    });
+    // The linear scan is too slow to run every query.
+    unsigned const n_linear = n_lookups / (n / 10'000) / 10;
+    auto const t_linear = time_ms([&] {
+      for (unsigned i{}; i != n_linear; ++i) {
+        auto const [s, e] = queries[i];
+        found_linear += linear_contains(evens, s, e);
+      }
+    }) * n_lookups / n_linear;
+
+    auto merged = evens;
+    auto const t_merge = time_ms([&] { merged.merge(odds); });
+
+    auto const t_merge_sort = time_ms([&] {
+      vector<EventRange> all;
+      std::merge(evens.begin(), evens.end(), odds.begin(), odds.end(),
+                 back_inserter(all));
+      RangeSet const result{run, all};
+    });
+
+    bool disjoint{};
+    auto const t_disjoint =
+      time_ms([&] { disjoint = disjoint_ranges(evens, odds); });
+
+    // Adjacent ranges collapse into one per subrun.
+    auto const n_subruns = (n + ranges_per_subrun - 1) / ranges_per_subrun;
+    if (found == 0 || found_linear == 0 || !disjoint ||
+        merged.ranges().size() != n_subruns) {
+      cerr << "Unexpected result.\n";
+      return 1;
+    }
+    cout << setw(10) << n << setw(18) << t_contains << setw(18) << t_linear
+         << setw(16) << t_merge << setw(20) << t_merge_sort << setw(18)
+         << t_disjoint << "\n";
+  }
+}
@@ -1,7 +1,9 @@
 #define BOOST_TEST_MODULE (RangeSet_t)
 #include "boost/test/unit_test.hpp"
 #include "canvas/Persistency/Provenance/RangeSet.h"
+#include "canvas/Persistency/Provenance/EventID.h"
 #include "canvas/Persistency/Provenance/RunID.h"
+#include "cetlib/crc32.h"
 
 #include <iostream>
 #include <string>
@@ -345,4 +347,99 @@ BOOST_AUTO_TEST_CASE(invalid)
   BOOST_TEST(!art::disjoint_ranges(rs1, rs2));
 }
 
+BOOST_AUTO_TEST_CASE(checksums)
+{
+  using Mode = RangeSet::ChecksumMode;
+  auto legacy = [](RangeSet const& rs) {
+    return cet::crc32{rs.to_compact_string()}.digest();
+  };
+
+  RangeSet rs{4};
+  rs.emplace_range(1, 2, 5);
+  rs.emplace_range(3, 1, 8);
+  BOOST_TEST(rs.checksum(Mode::legacy) == legacy(rs));
+  auto const before = rs.checksum();
+  BOOST_TEST(rs.checksum() == before);
+
+  // Each modification must invalidate the cached values.
+  rs.update(art::EventID{4, 3, 8});
+  BOOST_TEST(rs.checksum() != before);
+  BOOST_TEST(rs.checksum(Mode::legacy) == legacy(rs));
+
+  auto const [idx, split] = rs.split_range(1, 3);
+  BOOST_TEST(split);
+  BOOST_TEST(idx == 1u);
+  BOOST_TEST(rs.checksum(Mode::legacy) == legacy(rs));
+
+  RangeSet other{4};
+  other.emplace_range(3, 9, 12);
+  auto const afterSplit = rs.checksum();
+  rs.merge(other);
+  BOOST_TEST(rs.checksum() != afterSplit);
+  BOOST_TEST(rs.checksum(Mode::legacy) == legacy(rs));
+
+  // Equal range sets have equal checksums, however they were built.
+  RangeSet const expected{4, {EventRange{1, 2, 5}, EventRange{3, 1, 12}}};
+  BOOST_TEST(rs == expected);
+  BOOST_TEST(rs.checksum() == expected.checksum());
+  BOOST_TEST(rs.checksum(Mode::legacy) == expected.checksum(Mode::legacy));
+
+  BOOST_TEST(RangeSet::invalid().checksum(Mode::legacy) ==
+             legacy(RangeSet::invalid()));
+}
+
+BOOST_AUTO_TEST_CASE(indexed)
+{
+  // Fragmented ranges: [2,4), [5,6), [8,11), ... in each of three
+  // subruns, filled event by event.
+  RangeSet rs{3};
+  for (unsigned sr = 0; sr != 3; ++sr) {
+    for (unsigned e = 2; e < 200; e += 6) {
+      rs.update(art::EventID{3, sr, e});
+      rs.update(art::EventID{3, sr, e + 1});
+      rs.update(art::EventID{3, sr, e + 3});
+    }
+  }
+  BOOST_TEST(rs.is_indexed());
+
+  // Linear search over an unindexed copy gives the reference answer.
+  RangeSet unsorted{3};
+  for (auto it = rs.ranges().crbegin(); it != rs.ranges().crend(); ++it) {
+    unsorted.emplace_range(*it);
+  }
+  BOOST_TEST(!unsorted.is_indexed());
+  for (unsigned sr = 0; sr != 4; ++sr) {
+    for (unsigned e = 0; e != 210; ++e) {
+      BOOST_TEST(rs.contains(3, sr, e) == unsorted.contains(3, sr, e));
+    }
+  }
+  BOOST_TEST(!rs.contains(2, 0, 2));
+
+  // The events not yet seen, merged in, fill each subrun completely.
+  RangeSet rest{3};
+  for (unsigned sr = 0; sr != 3; ++sr) {
+    for (unsigned e = 2; e < 200; e += 6) {
+      rest.emplace_range(sr, e + 2, e + 3);
+      rest.emplace_range(sr, e + 4, e + 6);
+    }
+  }
+  BOOST_TEST(rest.is_indexed());
+  BOOST_TEST(art::disjoint_ranges(rs, rest));
+  BOOST_TEST(art::disjoint_ranges(rest, rs));
+  BOOST_TEST(!art::disjoint_ranges(rs, rs.merge(RangeSet{3})));
+
+  RangeSet const expected{3,
+                          {EventRange{0, 2, 200},
+                           EventRange{1, 2, 200},
+                           EventRange{2, 2, 200}}};
+  BOOST_TEST(rs.merge(rest) == expected);
+  BOOST_TEST(rs.is_indexed());
+  BOOST_TEST(!art::disjoint_ranges(rs, rest));
+
+  BOOST_CHECK_EXCEPTION(
+    rs.merge(rest), art::Exception, [](art::Exception const& e) {
+      return e.categoryCode() == art::errors::EventRangeOverlap;
+    });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,151 @@
+// vim: set sw=2 :
+
+// Compare the throughput of EventIDMatcher (single and batched
+// matching) with that of the nested-vector matching it replaced,
+// which walks every range of every pattern for each event.
+//
+// Usage: EventIDMatcher_bench [events]  (default 10^7)
+
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Utilities/EventIDMatcher.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace art;
+using namespace std;
+
+namespace {
+
+  // The previous representation and matching algorithm.
+  class NestedMatcher {
+  public:
+    explicit NestedMatcher(vector<string> const& patterns)
+    {
+      for (auto const& pattern : patterns) {
+        auto& parsed = patterns_.emplace_back(3);
+        istringstream parts{pattern};
+        string part;
+        for (unsigned i{}; i != 3 && getline(parts, part, ':'); ++i) {
+          istringstream elements{part};
+          string element;
+          while (getline(elements, element, ',')) {
+            if (element.find('*') != string::npos) {
+              parsed[i].push_back({0, 0, true});
+              continue;
+            }
+            auto const dash = element.find('-');
+            unsigned const low = stoul(element.substr(0, dash));
+            unsigned const high =
+              dash == string::npos ? low : stoul(element.substr(dash + 1));
+            parsed[i].push_back({low, high, false});
+          }
+        }
+      }
+    }
+
+    bool
+    match(EventID const& eid) const
+    {
+      unsigned const values[3]{eid.run(), eid.subRun(), eid.event()};
+      for (auto const& parsed : patterns_) {
+        bool ret = false;
+        for (unsigned i{}; i != 3; ++i) {
+          ret = false;
+          for (auto const& val : parsed[i]) {
+            if (val.wildcard ||
+                (values[i] >= val.low && values[i] <= val.high)) {
+              ret = true;
+              break;
+            }
+          }
+          if (!ret) {
+            break;
+          }
+        }
+        if (ret) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+  private:
+    struct Element {
+      unsigned low;
+      unsigned high;
+      bool wildcard;
+    };
+    vector<vector<vector<Element>>> patterns_;
+  };
+
+  template <typename F>
+  double
+  rate(unsigned const n_events, F f)
+  {
+    auto const start = chrono::steady_clock::now();
+    f();
+    chrono::duration<double> const elapsed =
+      chrono::steady_clock::now() - start;
+    return n_events / elapsed.count() / 1e6;
+  }
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const n_events = argc > 1 ? atoi(argv[1]) : 10'000'000;
+
+  // A typical skim: a few wildcard patterns plus a long list of
+  // selected events.
+  vector<string> patterns{"1-3 : * : 1-100", "4 : 0-9, 20-29 : *"};
+  for (unsigned i{}; i != 50; ++i) {
+    patterns.push_back(to_string(5 + i % 5) + " : " + to_string(i) + " : " +
+                       to_string(7 * i) + ", " + to_string(7 * i + 3) + "-" +
+                       to_string(7 * i + 5));
+  }
+  EventIDMatcher const matcher{patterns};
+  NestedMatcher const nested{patterns};
+
+  // Events in file order: runs of consecutive events per subrun.
+  vector<EventID> eids;
+  eids.reserve(n_events);
+  for (unsigned i{}; eids.size() != n_events; ++i) {
+    eids.emplace_back(1 + i / 100'000 % 10, i / 1000 % 100, 1 + i % 1000);
+  }
+
+  unsigned n_nested{}, n_single{};
+  auto const t_nested = rate(n_events, [&] {
+    for (auto const& eid : eids) {
+      n_nested += nested.match(eid);
+    }
+  });
+  auto const t_single = rate(n_events, [&] {
+    for (auto const& eid : eids) {
+      n_single += matcher.match(eid);
+    }
+  });
+  vector<bool> result;
+  auto const t_batch = rate(n_events, [&] { matcher.match(eids, result); });
+
+  unsigned n_batch{};
+  for (bool const b : result) {
+    n_batch += b;
+  }
+  if (n_nested != n_single || n_nested != n_batch) {
+    cerr << "Matchers disagree: " << n_nested << ' ' << n_single << ' '
+         << n_batch << '\n';
+    return 1;
+  }
+
+  cout << "matched " << n_single << " of " << n_events << " events\n"
+       << setw(26) << "nested (Mevents/s): " << t_nested << '\n'
+       << setw(26) << "compiled (Mevents/s): " << t_single << '\n'
+       << setw(26) << "batched (Mevents/s): " << t_batch << '\n';
+}
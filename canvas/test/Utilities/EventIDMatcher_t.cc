@@ -34,6 +34,20 @@ dump_ids(vector<EventID> const& cont)
   }
 }
 
+// The batched interface must agree with matching one event at a time.
+void
+check_batch(EventIDMatcher const& m, vector<EventID> const& eids)
+{
+  vector<bool> result;
+  m.match(eids, result);
+  for (size_t i = 0; i != eids.size(); ++i) {
+    if (result[i] != m.match(eids[i])) {
+      cerr << "Batched match disagrees for " << eids[i] << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+}
+
 void
 find_matches(string const& pat,
              vector<EventID> const& eids,
@@ -56,6 +70,7 @@ find_matches(string const& pat,
       matches.push_back(val);
     }
   }
+  check_batch(m, eids);
 }
 
 void
@@ -80,6 +95,7 @@ find_list_matches(vector<string> const& pats,
       matches.push_back(val);
     }
   }
+  check_batch(m, eids);
 }
 
 void
@@ -374,4 +390,20 @@ main()
     };
     run_list_test(pats, eids, expected);
   }
+  if (1) {
+    // Overlapping patterns, and a pattern that can never match.
+    vector<string> pats = {
+      "9-10: * : 10"s,
+      "10: 8-9 : 9-10"s,
+      "4-1: * : *"s,
+    };
+    vector<EventID> expected = {
+      {9, 0, 10}, {9, 1, 10}, {9, 2, 10}, {9, 3, 10}, {9, 4, 10},
+      {9, 5, 10}, {9, 6, 10}, {9, 7, 10}, {9, 8, 10}, {9, 9, 10},
+      {10, 0, 10}, {10, 1, 10}, {10, 2, 10}, {10, 3, 10}, {10, 4, 10},
+      {10, 5, 10}, {10, 6, 10}, {10, 7, 10}, {10, 8, 9}, {10, 8, 10},
+      {10, 9, 9}, {10, 9, 10},
+    };
+    run_list_test(pats, eids, expected);
+  }
 }
@@ -0,0 +1,85 @@
+// vim: set sw=2 expandtab :
+
+// Measure the time to form the friendly names of a job's worth of
+// distinct product types, as done when the product tables are built at
+// startup, compared with the original std::regex-based translation.
+//
+// Usage: FriendlyName_bench [types]  (default 5000)
+
+#include "canvas/Utilities/FriendlyName.h"
+#include "canvas/test/Utilities/FriendlyName_reference.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+  vector<string>
+  make_type_names(unsigned const n)
+  {
+    vector<string> const shapes{
+      "std::vector<ns::Product%>",
+      "art::Assns<ns::Product%,recob::Hit,void>",
+      "std::vector<art::Ptr<ns::Product%> >",
+      "std::map<unsigned int,std::vector<ns::Product%> >",
+      "art::Assns<recob::Track,ns::Product%,std::pair<unsigned long,double> >",
+      "cet::map_vector<std::pair<ns::Product%,std::string> >",
+      "ns::Product%"};
+    vector<string> result;
+    result.reserve(n);
+    for (unsigned i{}; i != n; ++i) {
+      auto name = shapes[i % shapes.size()];
+      name.replace(name.find('%'), 1, to_string(i));
+      result.push_back("art::Wrapper<" + name + " >");
+    }
+    return result;
+  }
+
+  template <typename F>
+  double
+  time_ms(vector<string> const& names, F f)
+  {
+    size_t total{};
+    auto const start = chrono::steady_clock::now();
+    for (auto const& name : names) {
+      total += f(name).size();
+    }
+    chrono::duration<double, milli> const elapsed =
+      chrono::steady_clock::now() - start;
+    if (total == 0) {
+      cerr << "No names produced.\n";
+      exit(1);
+    }
+    return elapsed.count();
+  }
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const n_types = argc > 1 ? atoi(argv[1]) : 5000;
+  auto const names = make_type_names(n_types);
+
+  for (auto const& name : names) {
+    if (art::friendlyname::friendlyName(name) !=
+        friendlyname_reference::friendlyName(name)) {
+      cerr << "Translations differ for " << name << '\n';
+      return 1;
+    }
+  }
+
+  // The library caches translations, so the names must be fresh.
+  auto const fresh = make_type_names(2 * n_types);
+  vector<string> const unseen(fresh.cbegin() + n_types, fresh.cend());
+  auto const t_new = time_ms(unseen, art::friendlyname::friendlyName);
+  auto const t_regex = time_ms(unseen, friendlyname_reference::friendlyName);
+  cout << n_types << " types\n"
+       << "  friendlyName: " << t_new << " ms\n"
+       << "  std::regex:   " << t_regex << " ms\n";
+}
@@ -0,0 +1,115 @@
+#ifndef canvas_test_Utilities_FriendlyName_reference_h
+#define canvas_test_Utilities_FriendlyName_reference_h
+// vim: set sw=2 expandtab :
+
+#include <regex>
+#include <stdexcept>
+#include <string>
+
+// The original, std::regex-based translation, against which the
+// library's translation is checked and benchmarked.
+namespace friendlyname_reference {
+
+  inline std::regex const reAllSpaces{" +"};
+  inline std::regex const reAssns{"art::Assns"};
+  inline std::regex const reBeginSpace{"^ +"};
+  inline std::regex const reComma{","};
+  inline std::regex const reEndSpace{" +$"};
+  inline std::regex const reParens{"(\\(|\\))"};
+  inline std::regex const reFirstTwoArgs{"^([^,]+),([^,]+)"};
+  inline std::regex const reLong{"long "};
+  inline std::regex const reLongLong{"Long64_t"};
+  inline std::regex const reMapVector{"cet::map_vector"};
+  inline std::regex const reMapVectorKey{"cet::map_vector_key"};
+  inline std::regex const reString{
+    "(?:std::basic_string<char>|std::string)"};
+  inline std::regex const reTemplateArgs{"([^<]*)<(.*)>$"};
+  inline std::regex const reTemplateClass{"([^<>,]+<[^<>]*>)"};
+  inline std::regex const reULongLong{"ULong64_t"};
+  inline std::regex const reUnsigned{"unsigned "};
+  inline std::regex const reVector{"std::vector"};
+  inline std::regex const reWrapper{"art::Wrapper<(.*)>"};
+
+  inline std::string
+  removeExtraSpaces(std::string const& in)
+  {
+    return std::regex_replace(std::regex_replace(in, reBeginSpace, ""),
+                              reEndSpace,
+                              "");
+  }
+
+  inline std::string
+  standardRenames(std::string const& in)
+  {
+    std::string name{std::regex_replace(in, reWrapper, "$1")};
+    name = std::regex_replace(name, reString, "String");
+    name = std::regex_replace(name, reUnsigned, "u");
+    name = std::regex_replace(name, reLong, "l");
+    name = std::regex_replace(name, reULongLong, "ull");
+    name = std::regex_replace(name, reLongLong, "ll");
+    name = std::regex_replace(name, reVector, "s");
+    name = std::regex_replace(name, reMapVectorKey, "mvk");
+    name = std::regex_replace(name, reMapVector, "mv");
+    return name;
+  }
+
+  inline std::string handleTemplateArguments(std::string const&,
+                                             std::string const&);
+  inline std::string
+  subFriendlyName(std::string const& iFullName)
+  {
+    std::string result{removeExtraSpaces(iFullName)};
+    std::smatch theMatch;
+    if (std::regex_match(result, theMatch, reTemplateArgs)) {
+      std::string const cMatch{theMatch.str(1)};
+      std::string const aMatch{theMatch.str(2)};
+      std::string const theSub{handleTemplateArguments(cMatch, aMatch)};
+      auto const escapeParens = [](std::string const& in) {
+        return std::regex_replace(in, reParens, "\\$1");
+      };
+      std::regex const eMatch{std::string{"^"} + escapeParens(cMatch) + '<' +
+                              escapeParens(aMatch) + '>'};
+      result = std::regex_replace(result, eMatch, theSub + cMatch);
+    }
+    return result;
+  }
+
+  inline std::string
+  handleTemplateArguments(std::string const& cName,
+                          std::string const& tArgs)
+  {
+    std::string result{removeExtraSpaces(tArgs)};
+    while (std::string::npos != result.find_first_of("<")) {
+      std::smatch theMatch;
+      if (!std::regex_search(result, theMatch, reTemplateClass)) {
+        throw std::runtime_error("No template match");
+      }
+      std::string const templateClass{theMatch.str(1)};
+      std::string const friendlierName{std::regex_replace(
+        subFriendlyName(templateClass), reAllSpaces, "")};
+      result =
+        std::regex_replace(result, std::regex(templateClass), friendlierName);
+    }
+    if (std::regex_match(cName, reAssns)) {
+      std::smatch theMatch;
+      if (std::regex_search(result, theMatch, reFirstTwoArgs) &&
+          (theMatch.str(1) > theMatch.str(2))) {
+        result = std::regex_replace(result, reFirstTwoArgs, "$2,$1");
+      }
+    }
+    return std::regex_replace(result, reComma, "");
+  }
+
+  inline std::string
+  friendlyName(std::string const& name)
+  {
+    return subFriendlyName(standardRenames(name));
+  }
+
+} // namespace friendlyname_reference
+
+#endif /* canvas_test_Utilities_FriendlyName_reference_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -2,12 +2,63 @@
 #include "boost/test/unit_test.hpp"
 
 #include "canvas/Utilities/FriendlyName.h"
+#include "canvas/test/Utilities/FriendlyName_reference.h"
 
 #include <map>
+#include <random>
 #include <string>
+#include <vector>
 
 namespace {
   using fnmap_t = std::map<std::string, std::string>;
+
+  // Random class names built from commonly-used product types.
+  // Neither parenthesized names nor pointers are used as arguments of
+  // nested templates, for which the reference implementation never
+  // terminates.
+  class NameGenerator {
+  public:
+    std::string
+    operator()(unsigned const depth = 0)
+    {
+      static std::vector<std::string> const leaves{
+        "int",          "unsigned int",      "long",
+        "unsigned long", "long long",        "ULong64_t",
+        "Long64_t",     "double",            "std::string",
+        "std::basic_string<char>",           "cet::map_vector_key",
+        "recob::Hit",   "recob::Track",      "sim::SimChannel",
+        "art::Wrapper", "Hit",               "art::Assns",
+        "art::Ptr",     "  Foo  "};
+      static std::vector<std::string> const templates{
+        "std::vector",  "art::Assns",       "art::Ptr",
+        "std::map",     "std::pair",        "cet::map_vector",
+        "art::Wrapper", "art::PtrVector",   "Hit",
+        "art::Hit",     "ns::Outer<int>::Inner", "std::set"};
+      if (depth > 3 || dist_(gen_) < 4) {
+        return pick(leaves);
+      }
+      auto result = pick(templates) + '<';
+      auto const n_args = 1 + dist_(gen_) % 3;
+      for (unsigned i{}; i != n_args; ++i) {
+        if (i != 0) {
+          result += dist_(gen_) < 5 ? ", " : ",";
+        }
+        result += (*this)(depth + 1);
+      }
+      result += dist_(gen_) < 5 ? " >" : ">";
+      return result;
+    }
+
+  private:
+    std::string const&
+    pick(std::vector<std::string> const& v)
+    {
+      return v[dist_(gen_) % v.size()];
+    }
+
+    std::mt19937 gen_{20231018};
+    std::uniform_int_distribution<unsigned> dist_{0, 9};
+  };
 }
 
 struct FriendlyNameTestFixture {
@@ -47,4 +98,57 @@ BOOST_AUTO_TEST_CASE(FriendlyName_t)
   }
 }
 
+BOOST_AUTO_TEST_CASE(MatchesRegexTranslation)
+{
+  std::vector<std::string> corpus{
+    "std::vector<recob::Hit>",
+    "std::vector<recob::Hit, std::allocator<recob::Hit> >",
+    "art::Wrapper<std::vector<art::Ptr<recob::Hit> > >",
+    "art::Assns<recob::Track,recob::Hit,recob::TrackHitMeta>",
+    "art::Assns<recob::Hit,recob::Track,void>",
+    "art::Assns<sim::MCParticle, simb::MCTruth, sim::GeneratedParticleInfo>",
+    "std::map<unsigned int,std::vector<double> >",
+    "std::map<std::basic_string<char>,std::pair<long,unsigned long long> >",
+    "cet::map_vector<std::pair<ULong64_t,Long64_t> >",
+    "art::PtrVector<recob::Cluster>",
+    "std::vector<std::vector<std::vector<float> > >",
+    "std::pair<art::Ptr<Hit>, Hit<int> >",
+    "std::pair<Hit<int>,art::Hit<int> >",
+    "ns::Outer<int>::Inner<double>",
+    "std::vector<(anonymous namespace)::Foo>",
+    "(anonymous namespace)::Foo<int>",
+    "std::set<art::Ptr<recob::Hit>,std::less<art::Ptr<recob::Hit> > >",
+    "art::Wrapper<MuonDigiCollection<CSCDetId,CSCALCTDigi> >",
+    "std::vector<Foo*>",
+    "std::vector<std::array<int,3> >",
+    "  padded<  A ,  B  >  ",
+    "",
+    "Foo",
+  };
+  NameGenerator generate;
+  for (unsigned i{}; i != 1000; ++i) {
+    corpus.push_back(generate());
+  }
+  // Malformed names (e.g. those with a stray "art::Wrapper<")
+  // must be rejected by both translations.
+  auto const translate = [](auto f, std::string const& name) {
+    try {
+      return f(name);
+    }
+    catch (std::exception const&) {
+      return std::string{"<no template match>"};
+    }
+  };
+  for (auto const& name : corpus) {
+    BOOST_TEST(translate(art::friendlyname::friendlyName, name) ==
+                 translate(friendlyname_reference::friendlyName, name),
+               '"' << name << '"');
+  }
+
+  // The reference translation never terminates for this name.
+  BOOST_CHECK_THROW(
+    art::friendlyname::friendlyName("std::vector<art::Ptr<Foo*> >"),
+    std::exception);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,8 @@
 
 #include <set>
 #include <string>
+#include <unordered_set>
+#include <utility>
 
 BOOST_AUTO_TEST_SUITE(InputTag_t)
 BOOST_AUTO_TEST_CASE(InputTag_default_ctor)
@@ -144,4 +146,78 @@ BOOST_AUTO_TEST_CASE(InputTag_set)
   BOOST_TEST(test.emplace("c:i").second == false);
 }
 
+BOOST_AUTO_TEST_CASE(InputTag_interned)
+{
+  art::InputTag const a{"alabel:aname:aprocess"};
+  BOOST_TEST(!a.is_interned());
+  auto const a1 = a.interned();
+  auto const a2 = art::InputTag{"alabel", "aname", "aprocess"}.interned();
+  BOOST_TEST(a1.is_interned());
+  BOOST_TEST(a1.label() == "alabel");
+  BOOST_TEST(a1.instance() == "aname");
+  BOOST_TEST(a1.process() == "aprocess");
+  BOOST_TEST(a1.encode() == a.encode());
+  BOOST_TEST(a1.interned().is_interned());
+
+  BOOST_TEST(a1 == a2);
+  BOOST_TEST(a1 == a);
+  BOOST_TEST(a == a1);
+  BOOST_TEST(a1.hash() == a.hash());
+  BOOST_TEST(std::hash<art::InputTag>{}(a1) == a.hash());
+
+  art::InputTag const b{"alabel:aname"};
+  auto const b1 = b.interned();
+  BOOST_TEST(a1 != b1);
+  BOOST_TEST(a != b1);
+  BOOST_TEST(b1.encode() == "alabel:aname");
+  BOOST_TEST(!b1.empty());
+  BOOST_TEST(art::InputTag{}.interned().empty());
+
+  // Copies of an interned tag are interned.
+  auto a3 = a1;
+  BOOST_TEST(a3.is_interned());
+  a3 = b;
+  BOOST_TEST(!a3.is_interned());
+  BOOST_TEST(a3 == b1);
+}
+
+BOOST_AUTO_TEST_CASE(InputTag_interned_moved_from)
+{
+  art::InputTag const original{"alabel", "aname", "aprocess"};
+  auto a1 = original.interned();
+  auto const a2 = std::move(a1);
+  BOOST_TEST(a2.is_interned());
+  BOOST_TEST(a2 == original);
+  BOOST_TEST(!a1.is_interned());
+
+  auto a3 = original.interned();
+  art::InputTag a4;
+  a4 = std::move(a3);
+  BOOST_TEST(a4.is_interned());
+  BOOST_TEST(a4 == original);
+  BOOST_TEST(!a3.is_interned());
+
+  // A moved-from tag equals the original only if its names do.
+  if (a1.empty()) {
+    BOOST_TEST(a1 != a2);
+    BOOST_TEST(a1.hash() != a2.hash());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(InputTag_interned_containers)
+{
+  std::unordered_set<art::InputTag> tags{art::InputTag{"c", "i"},
+                                         art::InputTag{"a::"}};
+  BOOST_TEST(!tags.emplace(art::InputTag{"c:i"}.interned()).second);
+  BOOST_TEST(tags.emplace(art::InputTag{"b"}.interned()).second);
+  BOOST_TEST(tags.count(art::InputTag{"b"}) == 1u);
+  BOOST_TEST(tags.count(art::InputTag{"a"}.interned()) == 1u);
+
+  std::set<art::InputTag> ordered{art::InputTag{"c", "i"}.interned(),
+                                  art::InputTag{"a::"},
+                                  art::InputTag{"b"}.interned()};
+  std::vector<art::InputTag> const ref{"a::", "b", "c:i:"};
+  BOOST_TEST(ordered == ref, boost::test_tools::per_element{});
+}
+
 BOOST_AUTO_TEST_SUITE_END()
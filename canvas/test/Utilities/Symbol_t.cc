@@ -0,0 +1,81 @@
+#define BOOST_TEST_MODULE (Symbol_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Utilities/Exception.h"
+#include "canvas/Utilities/Symbol.h"
+#include "hep_concurrency/simultaneous_function_spawner.h"
+
+#include <atomic>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using art::Symbol;
+
+BOOST_AUTO_TEST_SUITE(Symbol_t)
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+  Symbol const a{"Symbol_t_a"};
+  Symbol const b{std::string{"Symbol_t_b"}};
+  Symbol const a2{std::string{"Symbol_t_"} + "a"};
+  BOOST_TEST(a.is_valid());
+  BOOST_TEST((a == a2));
+  BOOST_TEST((a != b));
+  BOOST_TEST(a.str() == "Symbol_t_a");
+  BOOST_TEST(&a.str() == &a2.str());
+  BOOST_TEST(b.str() == "Symbol_t_b");
+
+  Symbol const empty{""};
+  BOOST_TEST(empty.is_valid());
+  BOOST_TEST(empty.str().empty());
+
+  std::ostringstream os;
+  os << a << ' ' << Symbol{};
+  BOOST_TEST(os.str() == "Symbol_t_a <invalid symbol>");
+}
+
+BOOST_AUTO_TEST_CASE(find)
+{
+  BOOST_TEST(!Symbol::find("Symbol_t_never_interned").is_valid());
+  Symbol const c{"Symbol_t_c"};
+  BOOST_TEST((Symbol::find("Symbol_t_c") == c));
+
+  Symbol const invalid;
+  BOOST_TEST(!invalid.is_valid());
+  BOOST_TEST((invalid != Symbol{""}));
+  BOOST_CHECK_THROW(invalid.str(), art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+  constexpr unsigned n_strings{2000};
+  constexpr unsigned n_threads{8};
+  std::vector<std::vector<Symbol>> results(n_threads);
+  std::vector<std::function<void()>> tasks;
+  for (unsigned t = 0; t != n_threads; ++t) {
+    tasks.push_back([&result = results[t], t] {
+      // Each thread interns the same strings, in a different order.
+      for (unsigned i = 0; i != n_strings; ++i) {
+        auto const n = (i * 7 + t * 131) % n_strings;
+        result.emplace_back("concurrent" + std::to_string(n));
+      }
+    });
+  }
+  hep::concurrency::simultaneous_function_spawner sfs{tasks};
+
+  std::atomic<unsigned> failures{};
+  for (unsigned t = 0; t != n_threads; ++t) {
+    for (unsigned i = 0; i != n_strings; ++i) {
+      auto const n = (i * 7 + t * 131) % n_strings;
+      auto const s = "concurrent" + std::to_string(n);
+      if (results[t][i].str() != s || results[t][i] != Symbol::find(s)) {
+        ++failures;
+      }
+    }
+  }
+  BOOST_TEST(failures == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
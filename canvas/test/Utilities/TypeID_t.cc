@@ -3,9 +3,13 @@
 #include "boost/test/unit_test.hpp"
 
 #include "canvas/Utilities/TypeID.h"
+#include "hep_concurrency/simultaneous_function_spawner.h"
 
+#include <atomic>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace arttest {
   struct empty {};
@@ -64,4 +68,53 @@ BOOST_AUTO_TEST_CASE(TypeID_type)
   BOOST_TEST(os.is_equal("arttest::also_empty"));
 }
 
+BOOST_AUTO_TEST_CASE(TypeID_of)
+{
+  auto const id1 = art::TypeID::of<arttest::empty>();
+  art::TypeID const id2{typeid(arttest::empty)};
+  BOOST_TEST(id1 == id2);
+  BOOST_TEST(!(id1 < id2));
+  BOOST_TEST(id1.className() == "arttest::empty");
+  // Both forms refer to the same cached name.
+  BOOST_TEST(&id1.className() == &id2.className());
+
+  auto id3 = art::TypeID::of<arttest::also_empty>();
+  auto id4 = id1;
+  swap(id3, id4);
+  BOOST_TEST(id3.className() == "arttest::empty");
+  BOOST_TEST(id4.className() == "arttest::also_empty");
+}
+
+BOOST_AUTO_TEST_CASE(TypeID_concurrent_className)
+{
+  std::vector<art::TypeID> const ids{art::TypeID{typeid(int)},
+                                     art::TypeID{typeid(std::string)},
+                                     art::TypeID{typeid(std::vector<int>)},
+                                     art::TypeID::of<std::vector<double>>()};
+  std::vector<std::string const*> addresses(ids.size());
+  for (std::size_t i = 0; i != ids.size(); ++i) {
+    addresses[i] = &ids[i].className();
+  }
+
+  std::atomic<unsigned> failures{};
+  std::vector<std::function<void()>> tasks;
+  for (unsigned t = 0; t != 8; ++t) {
+    tasks.push_back([&ids, &addresses, &failures] {
+      for (unsigned n = 0; n != 1000; ++n) {
+        for (std::size_t i = 0; i != ids.size(); ++i) {
+          if (&ids[i].className() != addresses[i]) {
+            ++failures;
+          }
+        }
+      }
+    });
+  }
+  hep::concurrency::simultaneous_function_spawner sfs{tasks};
+  BOOST_TEST(failures == 0u);
+  BOOST_TEST(*addresses[0] == "int");
+  BOOST_TEST(*addresses[1] == "std::string");
+  BOOST_TEST(*addresses[2] == "std::vector<int>");
+  BOOST_TEST(*addresses[3] == "std::vector<double>");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+// vim: set sw=2 expandtab :
+
+// Compare the time taken by uniform_type_name with that of the
+// original, std::regex-based implementation, for the demangled names
+// of a set of STL and art types.
+//
+// Usage: uniform_type_name_bench [iterations]  (default 10^4)
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Utilities/InputTag.h"
+#include "canvas/Utilities/uniform_type_name.h"
+#include "canvas/test/Utilities/uniform_type_name_reference.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+  vector<string>
+  demangled_names()
+  {
+    vector<type_info const*> const types{
+      &typeid(vector<string>),
+      &typeid(map<string, vector<int>>),
+      &typeid(set<unsigned long>),
+      &typeid(pair<unsigned long long const, long long>),
+      &typeid(vector<vector<pair<unsigned long long, double>>>),
+      &typeid(map<unsigned int, vector<string>>),
+      &typeid(art::Ptr<string>),
+      &typeid(vector<art::Ptr<double>>),
+      &typeid(art::Assns<int, double, string>),
+      &typeid(map<art::EventID, vector<art::InputTag>>),
+    };
+    vector<string> result;
+    for (auto const* type : types) {
+      result.push_back(cet::demangle_symbol(type->name()));
+    }
+    return result;
+  }
+
+  template <typename F>
+  double
+  time_us(vector<string> const& names, unsigned const n_iterations, F f)
+  {
+    size_t total{};
+    auto const start = chrono::steady_clock::now();
+    for (unsigned i{}; i != n_iterations; ++i) {
+      for (auto const& name : names) {
+        total += f(name).size();
+      }
+    }
+    chrono::duration<double, micro> const elapsed =
+      chrono::steady_clock::now() - start;
+    if (total == 0) {
+      cerr << "No names produced.\n";
+      exit(1);
+    }
+    return elapsed.count() / (n_iterations * names.size());
+  }
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const n_iterations = argc > 1 ? atoi(argv[1]) : 10'000;
+  auto const names = demangled_names();
+  for (auto const& name : names) {
+    if (art::uniform_type_name(name) !=
+        uniform_type_name_reference::uniform_type_name(name)) {
+      cerr << "Results differ for " << name << '\n';
+      return 1;
+    }
+  }
+  auto const t_new = time_us(names, n_iterations, [](string const& name) {
+    return art::uniform_type_name(name);
+  });
+  auto const t_regex = time_us(
+    names, n_iterations, uniform_type_name_reference::uniform_type_name);
+  cout << "Time per name, " << names.size() << " names:\n"
+       << "  uniform_type_name: " << t_new << " us\n"
+       << "  std::regex:        " << t_regex << " us\n";
+}
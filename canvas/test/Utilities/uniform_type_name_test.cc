@@ -2,9 +2,18 @@
 #include "boost/test/unit_test.hpp"
 
 #include "canvas/Utilities/uniform_type_name.h"
+#include "canvas/test/Utilities/uniform_type_name_reference.h"
 
+#include <array>
+#include <bitset>
+#include <functional>
+#include <list>
 #include <map>
+#include <set>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 using art::uniform_type_name;
@@ -47,4 +56,53 @@ BOOST_AUTO_TEST_CASE(int_type_names)
          "MyULongTemplate_t<4,std::string>");
 }
 
+BOOST_AUTO_TEST_CASE(matches_regex_implementation)
+{
+  std::vector<std::string> const names{
+    cet::demangle_symbol(typeid(std::vector<std::string>).name()),
+    cet::demangle_symbol(
+      typeid(std::map<std::string, std::vector<int>>).name()),
+    cet::demangle_symbol(typeid(std::set<unsigned long>).name()),
+    cet::demangle_symbol(
+      typeid(std::unordered_map<unsigned, std::string>).name()),
+    cet::demangle_symbol(typeid(std::pair<int const, double>).name()),
+    cet::demangle_symbol(typeid(std::array<int, 3>).name()),
+    cet::demangle_symbol(typeid(std::bitset<8>).name()),
+    cet::demangle_symbol(
+      typeid(std::tuple<long long, unsigned long long, char const*>).name()),
+    cet::demangle_symbol(
+      typeid(std::vector<std::vector<std::pair<unsigned long long, long long>>>)
+        .name()),
+    cet::demangle_symbol(
+      typeid(std::list<std::map<int, std::set<std::string>>>).name()),
+    cet::demangle_symbol(typeid(std::function<void(int, double)>).name()),
+    cet::demangle_symbol(typeid(std::basic_string<wchar_t>).name()),
+    cet::demangle_symbol(typeid(MyUIntTemplate_t<3u, std::string>).name()),
+    cet::demangle_symbol(
+      typeid(MyULongTemplate_t<4ul, std::vector<std::string>>).name()),
+    // As demangled by libc++, and other less common forms.
+    "std::__1::vector<std::__1::basic_string<char, "
+    "std::__1::char_traits<char>, std::__1::allocator<char> >, "
+    "std::__1::allocator<std::__1::basic_string<char, "
+    "std::__1::char_traits<char>, std::__1::allocator<char> > > >",
+    "std::__1::__cxx11::basic_string<char>",
+    "std::__12::map<int, int, std::__12::less<int> >",
+    "std::__cxx12::list<int>",
+    "ststd::__1::d::__1::vector<int>",
+    "A<3ul, 4ull, 5lu, 6uu, 7u>",
+    "B<1u,2l,3ll>",
+    "C<std::basic_string<char>  \t>",
+    "D<E<F >  >",
+    "x<y<1> >> ",
+    "T<int const, std::vector<double const*> const>",
+    "Z<int [3], char [4]>",
+    "",
+  };
+  for (auto const& name : names) {
+    BOOST_TEST(uniform_type_name(name) ==
+                 uniform_type_name_reference::uniform_type_name(name),
+               '"' << name << '"');
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()